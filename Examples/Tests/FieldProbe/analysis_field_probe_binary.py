@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the binary output of the FieldProbe diagnostic. The input file
+inputs_2d is used, with a second line probe FP_line_bin identical to FP_line, but
+written with output_format = binary and buffer_size > 1 (see WarpX-tests.ini).
+The values read from FP_line_bin.bin must match the text output FP_line.txt.
+"""
+import numpy as np
+import pandas as pd
+
+def read_binary_probe(filename):
+    """Read the records (step, time, values) of a binary FieldProbe file.
+    The floating-point precision of the values is deduced from the size of the file."""
+    raw = open(filename, 'rb').read()
+    for real in [np.float64, np.float32]:
+        real_size = np.dtype(real).itemsize
+        records = []
+        offset = 0
+        while offset + 24 <= len(raw):
+            step = np.frombuffer(raw, np.int64, 1, offset)[0]
+            time = np.frombuffer(raw, np.float64, 1, offset + 8)[0]
+            n = np.frombuffer(raw, np.int64, 1, offset + 16)[0]
+            offset += 24
+            if n < 0 or offset + n*10*real_size > len(raw):
+                break
+            values = np.frombuffer(raw, real, n*10, offset).reshape((n, 10))
+            offset += n*10*real_size
+            records.append((step, time, values))
+        if offset == len(raw):
+            return records
+    raise RuntimeError(f'{filename} is not a valid binary FieldProbe file')
+
+records = read_binary_probe("diags/reducedfiles/FP_line_bin.bin")
+
+df = pd.read_csv("diags/reducedfiles/FP_line.txt", sep=' ')
+steps = np.unique(df['[0]step()'].to_numpy())
+
+# The binary file contains the same output steps as the text file,
+# including the steps still buffered at the end of the simulation
+assert len(records) == len(steps)
+for step, time, values in records:
+    assert step in steps
+    rows = df[df['[0]step()'] == step].to_numpy()
+    assert np.isclose(time, rows[0, 1], rtol=1e-12, atol=0.)
+    assert len(values) == len(rows)
+    # The points may be in a different order (they are grouped by MPI rank)
+    text_values = rows[np.lexsort(rows[:, 2:5].T[::-1]), 2:]
+    bin_values = values[np.lexsort(values[:, 0:3].T[::-1])]
+    # The text file is written with a finite number of digits
+    scale = np.maximum(np.max(np.abs(text_values), axis=0), np.finfo(np.float64).tiny)
+    assert np.all(np.abs(bin_values - text_values) <= 1e-10*scale)
+
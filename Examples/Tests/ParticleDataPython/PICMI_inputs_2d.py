@@ -152,6 +152,42 @@ new_pid_vals = sim.extension.get_particle_arrays(
 for vals in new_pid_vals:
     assert np.allclose(vals, 5)
 
+##########################
+# check that the batched
+# particle arrays match the
+# per-component arrays
+##########################
+
+comp_names = ['w', 'ux', 'uy', 'uz', 'newPid']
+batch = sim.extension.get_particle_arrays_batch('electrons', comp_names, 0)
+for comp_name in comp_names:
+    arrays = sim.extension.get_particle_arrays('electrons', comp_name, 0)
+    assert len(batch[comp_name]) == len(arrays)
+    for batch_vals, vals in zip(batch[comp_name], arrays):
+        assert np.array_equal(batch_vals, vals)
+
+# the attributes set by the bulk add are stored with every particle
+for vals in batch['w']:
+    assert np.allclose(vals, 2)
+for vals in batch['newPid']:
+    assert np.allclose(vals, 5)
+
+# the batched arrays are views of the particle data
+for vals in batch['newPid']:
+    vals[:] = 7.
+for vals in sim.extension.get_particle_arrays('electrons', 'newPid', 0):
+    assert np.allclose(vals, 7)
+for vals in batch['newPid']:
+    vals[:] = 5.
+
+# the particles added in bulk get distinct ids
+ids = np.concatenate([np.zeros(0, dtype=int)] + [
+    np.array(pid, dtype=int) for pid in sim.extension.get_particle_id('electrons')])
+cpus = np.concatenate([np.zeros(0, dtype=int)] + [
+    np.array(cpu, dtype=int) for cpu in sim.extension.get_particle_cpu('electrons')])
+assert np.all(ids > 0)
+assert len(set(zip(ids, cpus))) == len(ids)
+
 ##########################
 # take the final sim step
 ##########################
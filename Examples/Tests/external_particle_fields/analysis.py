@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the external fields applied to the particles, either evaluated
+for each particle from the parser functions, or tabulated on the grid
+(particles.B_ext_particle_tabulate = 1).
+The input file sets up a magnetic quadrupole and propagates two particles through it.
+One particle is in the X plane, where the quadrupole is focusing, the other in the Y plane,
+where it is defocusing. The final positions and momenta are compared to the analytic solutions,
+with the same tolerances for both methods.
+The motion is paraxial, and the change of longitudinal velocity is neglected.
+"""
+
+import sys
+
+import numpy as np
+from scipy.constants import c, e, m_e
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+filename = sys.argv[1]
+ds = yt.load( filename )
+ad = ds.all_data()
+
+# The particles may not be in order, so determine which is which
+# by looking at their max positions in the respective planes.
+i0 = np.argmax(np.abs(ad['electrons', 'particle_position_x'].v))
+i1 = np.argmax(np.abs(ad['electrons', 'particle_position_y'].v))
+
+xx_sim = ad['electrons', 'particle_position_x'].v[i0]
+yy_sim = ad['electrons', 'particle_position_y'].v[i1]
+zz_sim0 = ad['electrons', 'particle_position_z'].v[i0]
+zz_sim1 = ad['electrons', 'particle_position_z'].v[i1]
+
+ux_sim = ad['electrons', 'particle_momentum_x'].v[i0]/m_e
+uy_sim = ad['electrons', 'particle_momentum_y'].v[i1]/m_e
+
+clight = c
+vel_z = eval(ds.parameters.get('my_constants.vel_z'))
+gradient = float(ds.parameters.get('my_constants.gradient'))
+
+x0 = float(ds.parameters.get('electrons.multiple_particles_pos_x').split()[0])
+y0 = float(ds.parameters.get('electrons.multiple_particles_pos_y').split()[1])
+z0 = float(ds.parameters.get('electrons.multiple_particles_pos_z').split()[0])
+
+gamma = 1./np.sqrt(1. - vel_z**2/c**2)
+uz = gamma*vel_z
+
+# Focusing strength of the quadrupole: x'' = -k**2 x and y'' = k**2 y
+k = np.sqrt(-e*gradient/(m_e*gamma*vel_z))
+
+L0 = zz_sim0 - z0
+L1 = zz_sim1 - z0
+xx = x0*np.cos(k*L0)
+ux = -uz*x0*k*np.sin(k*L0)
+yy = y0*np.cosh(k*L1)
+uy = uz*y0*k*np.sinh(k*L1)
+
+print(f'Error in x position is {abs(np.abs((xx - xx_sim)/xx))}, which should be < 0.02')
+print(f'Error in y position is {abs(np.abs((yy - yy_sim)/yy))}, which should be < 0.02')
+print(f'Error in x velocity is {abs(np.abs((ux - ux_sim)/ux))}, which should be < 0.002')
+print(f'Error in y velocity is {abs(np.abs((uy - uy_sim)/uy))}, which should be < 0.002')
+
+assert abs(np.abs((xx - xx_sim)/xx)) < 0.02, Exception('error in x particle position')
+assert abs(np.abs((yy - yy_sim)/yy)) < 0.02, Exception('error in y particle position')
+assert abs(np.abs((ux - ux_sim)/ux)) < 0.002, Exception('error in x particle velocity')
+assert abs(np.abs((uy - uy_sim)/uy)) < 0.002, Exception('error in y particle velocity')
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the external fields applied to the particles when they are
+read from an openPMD file (particles.B_ext_particle_init_style = read_from_file).
+- Write the magnetic quadrupole of inputs_3d to an openPMD file, in single precision
+  and with a single point along z (the field is then uniform along z)
+- Run the WarpX simulation with the field read from this file
+- Compare the final positions and momenta of the particles to the analytic
+  solutions, with analysis.py (same tolerances as for the parser functions)
+"""
+
+import glob
+import os
+
+import numpy as np
+import openpmd_api as io
+
+# Must match my_constants.gradient in inputs_3d
+gradient = -5.9e-4
+
+def write_quadrupole(fname):
+    # The mesh covers the transverse extent of the domain. In C order, the
+    # axes are listed from the slowest to the fastest, and x is the fastest.
+    nx = ny = 5
+    x = np.linspace(-1., 1., nx)
+    y = np.linspace(-1., 1., ny)
+    Y, X = np.meshgrid(y, x, indexing='ij')
+    components = {
+        'x': (gradient*Y).astype(np.float32).reshape(1, ny, nx),
+        'y': (gradient*X).astype(np.float32).reshape(1, ny, nx),
+        'z': np.zeros((1, ny, nx), dtype=np.float32) }
+
+    series = io.Series(fname, io.Access.create)
+    B = series.iterations[0].meshes['B']
+    B.data_order = 'C'
+    B.axis_labels = ['z', 'y', 'x']
+    B.grid_spacing = [1., y[1] - y[0], x[1] - x[0]]
+    B.grid_global_offset = [0., -1., -1.]
+    B.grid_unit_SI = 1.
+    B.unit_dimension = {io.Unit_Dimension.M: 1,
+                        io.Unit_Dimension.I: -1,
+                        io.Unit_Dimension.T: -2}
+    for comp, data in components.items():
+        rc = B[comp]
+        rc.position = [0., 0., 0.]
+        rc.unit_SI = 1.
+        rc.reset_dataset(io.Dataset(data.dtype, data.shape))
+        rc.store_chunk(data)
+    series.flush()
+    del series
+
+def main():
+    executables = glob.glob('*.ex')
+    assert len(executables) == 1
+    write_quadrupole('quadrupole.h5')
+    assert os.system('./' + executables[0] + ' inputs_3d'
+                     ' particles.B_ext_particle_init_style = read_from_file'
+                     ' particles.read_fields_from_path = quadrupole.h5') == 0
+    assert os.system('python3 analysis.py diags/diag1000050') == 0
+    print('Passed')
+
+if __name__ == '__main__':
+    main()
@@ -69,6 +69,19 @@ print('Maxwell-Boltzmann distribution difference:', f2_error)
 assert(f1_error < tolerance)
 assert(f2_error < tolerance)
 
+# the histograms of h1x and h1y, computed in a single pass by h1xy,
+# must be identical to those of the two single-histogram diagnostics
+h1xy = read_reduced_diags_histogram("h1xy.txt")[3]
+h1xy_ux = h1xy[..., :h1x.shape[-1]]
+h1xy_uy = h1xy[..., h1x.shape[-1]:]
+
+print('Several histograms in one diagnostic, max difference:',
+      np.max(np.abs(h1xy_ux-h1x)), np.max(np.abs(h1xy_uy-h1y)))
+
+assert(h1xy.shape[-1] == h1x.shape[-1] + h1y.shape[-1])
+assert(np.allclose(h1xy_ux, h1x, rtol=1.e-12, atol=0.))
+assert(np.allclose(h1xy_uy, h1y, rtol=1.e-12, atol=0.))
+
 #================
 # maxwell-juttner
 #================
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the regridding of the refinement patches.
+
+The input file inputs_2d is used: a single electron crosses the domain,
+and the cells that contain it are refined (warpx.refine_particles_per_cell).
+The patch does not exist at initialization, since the particle is not injected
+yet when the initial grids are made. This script checks that, at the end of the
+simulation, the patch has been created by a regrid and has followed the
+electron: it contains the electron, but no longer its initial position.
+"""
+import sys
+
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+# Open plotfile specified in command line
+filename = sys.argv[1]
+ds = yt.load( filename )
+
+# Initial position of the electron, as in the input file
+x0 = -16.e-6
+z0 = 0.
+
+# Final position of the electron
+ad = ds.all_data()
+x = ad['electron', 'particle_position_x'].to_ndarray()
+z = ad['electron', 'particle_position_y'].to_ndarray()
+assert x.size == 1
+x = x[0]
+z = z[0]
+print('electron position: x = %s, z = %s' %(x, z))
+
+# The electron has moved by several times the width of the cells it was tagged in
+assert x - x0 > 8.e-6
+
+# Extent of the boxes of the refined level
+assert ds.max_level == 1
+boxes = [ (g.LeftEdge.to_ndarray(), g.RightEdge.to_ndarray())
+          for g in ds.index.grids if g.Level == 1 ]
+print('boxes of level 1:', boxes)
+
+def is_refined(x, z):
+    return any( lo[0] <= x <= hi[0] and lo[1] <= z <= hi[1] for lo, hi in boxes )
+
+assert is_refined(x, z)
+assert not is_refined(x0, z0)
@@ -0,0 +1,59 @@
+#!/usr/bin/env python
+
+# Copyright 2022 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the boundary scraping diagnostic when the scraped
+# particles are written to file during the simulation, whenever the
+# buffers exceed `diag3.max_buffer_size` (see the test `scraping` for
+# the setup). All the flushes must append to the same openPMD iteration,
+# so that the final output contains exactly the same particles as a run
+# that only writes the scraped particles at the end of the simulation.
+# The reference is given by the full diagnostic `diag2`: the number of
+# particles scraped at each step (recorded in the attribute `timestamp`)
+# must match the number of particles removed from the simulation at this step.
+
+# Possible errors: 0
+# tolerance: 0
+# Possible running time: < 1 s
+
+import sys
+
+import numpy as np
+from openpmd_viewer import OpenPMDTimeSeries
+import yt
+
+fn = sys.argv[1]
+ds = yt.load( fn )
+ad = ds.all_data()
+x = ad['electron', 'particle_position_x'].v
+# Same number of remaining particles as in the test without streaming
+assert len(x) == 512
+
+ts_full = OpenPMDTimeSeries('./diags/diag2/')
+ts_scraping = OpenPMDTimeSeries('./diags/diag3/')
+
+# A single iteration contains all the scraped particles
+assert len(ts_scraping.iterations) == 1
+
+def n_remaining_particles( iteration ):
+    w, = ts_full.get_particle(['w'], iteration=iteration)
+    return len(w)
+n_remaining = np.array([ n_remaining_particles(iteration) for iteration in ts_full.iterations ])
+n_total = n_remaining[0]
+
+timestamp, w = ts_scraping.get_particle( ['timestamp', 'w'],
+    iteration=ts_scraping.iterations[0] )
+
+# No particle is missing or duplicated, and none of the rows was left unwritten
+# (e.g. by a flush to another iteration)
+assert len(timestamp) == n_total - 512
+assert np.all( w > 0 )
+assert np.all( (timestamp >= 1) & (timestamp <= ts_full.iterations[-1]) )
+
+# Particles scraped at each step
+n_scraped = np.array([ (timestamp == iteration).sum() for iteration in ts_full.iterations[1:] ])
+assert np.all( n_scraped == n_remaining[:-1] - n_remaining[1:] )
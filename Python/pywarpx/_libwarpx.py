@@ -169,6 +169,7 @@ class LibWarpX():
         self.libwarpx_so.amrex_init_with_inited_mpi.argtypes = (ctypes.c_int, _LP_LP_c_char, _MPI_Comm_type)
         self.libwarpx_so.warpx_getParticleStructs.restype = _LP_particle_p
         self.libwarpx_so.warpx_getParticleArrays.restype = _LP_LP_c_particlereal
+        self.libwarpx_so.warpx_getParticleArraysBatch.restype = _LP_LP_c_particlereal
         self.libwarpx_so.warpx_getParticleCompIndex.restype = ctypes.c_int
         self.libwarpx_so.warpx_getEfield.restype = _LP_LP_c_real
         self.libwarpx_so.warpx_getEfieldLoVects.restype = _LP_c_int
@@ -750,6 +751,63 @@ class LibWarpX():
         _libc.free(data)
         return particle_data
 
+    def get_particle_arrays_batch(self, species_name, comp_names, level):
+        '''
+
+        This returns, for each of the requested components, a list of numpy
+        arrays containing the particle array data on each tile for this process.
+        All components are fetched with a single call into WarpX, which avoids
+        the per-component overhead of calling get_particle_arrays repeatedly.
+
+        The data for the numpy arrays are not copied, but share the underlying
+        memory buffer with WarpX. The numpy arrays are fully writeable.
+
+        Parameters
+        ----------
+
+            species_name   : the species name that the data will be returned for
+            comp_names     : list of the components of the array data that will be returned.
+            level          : the refinement level from which the arrays are returned
+
+        Returns
+        -------
+
+            A dictionary mapping each component name to a list of numpy arrays.
+
+        '''
+        ncomps = len(comp_names)
+        c_comp_names = (ctypes.c_char_p * ncomps)(
+            *[comp_name.encode('utf-8') for comp_name in comp_names]
+        )
+
+        particles_per_tile = _LP_c_int()
+        num_tiles = ctypes.c_int(0)
+        data = self.libwarpx_so.warpx_getParticleArraysBatch(
+            ctypes.c_char_p(species_name.encode('utf-8')),
+            c_comp_names, ncomps,
+            level, ctypes.byref(num_tiles), ctypes.byref(particles_per_tile)
+        )
+
+        particle_data = {comp_name: [] for comp_name in comp_names}
+        for i in range(num_tiles.value):
+            if particles_per_tile[i] == 0:
+                continue
+            for icomp, comp_name in enumerate(comp_names):
+                pointer = data[i*ncomps + icomp]
+                if not pointer:
+                    raise Exception(f'get_particle_arrays_batch: data for {comp_name} in tile {i} was not initialized')
+                arr = np.ctypeslib.as_array(pointer, (particles_per_tile[i],))
+                try:
+                    # This fails on some versions of numpy
+                    arr.setflags(write=1)
+                except ValueError:
+                    pass
+                particle_data[comp_name].append(arr)
+
+        _libc.free(particles_per_tile)
+        _libc.free(data)
+        return particle_data
+
     def get_particle_x(self, species_name, level=0):
         '''
 
@@ -745,8 +745,11 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
         const amrex::IntVect fill_guards = amrex::IntVect(0);
         const bool in_pml = true;
         const bool periodic_single_box = false;
+        const bool distributed_fft = false;
         const bool update_with_rho = false;
+        const bool current_correction = false;
         const bool fft_do_time_averaging = false;
+        const bool on_the_fly_coefficients = false;
         const RealVect dx{AMREX_D_DECL(geom->CellSize(0), geom->CellSize(1), geom->CellSize(2))};
         // Get the cell-centered box, with guard cells
         BoxArray realspace_ba = ba; // Copy box
@@ -755,8 +758,9 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
         realspace_ba.enclosedCells().grow(nge); // cell-centered + guard cells
         spectral_solver_fp = std::make_unique<SpectralSolver>(lev, realspace_ba, dm,
             nox_fft, noy_fft, noz_fft, do_nodal, fill_guards, v_galilean_zero,
-            v_comoving_zero, dx, dt, in_pml, periodic_single_box, update_with_rho,
-            fft_do_time_averaging, do_multi_J, m_dive_cleaning, m_divb_cleaning);
+            v_comoving_zero, dx, dt, in_pml, periodic_single_box, distributed_fft, update_with_rho,
+            current_correction, fft_do_time_averaging, do_multi_J, m_dive_cleaning, m_divb_cleaning,
+            on_the_fly_coefficients);
 #endif
     }
 
@@ -865,8 +869,11 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
             const amrex::IntVect fill_guards = amrex::IntVect(0);
             const bool in_pml = true;
             const bool periodic_single_box = false;
+            const bool distributed_fft = false;
             const bool update_with_rho = false;
+            const bool current_correction = false;
             const bool fft_do_time_averaging = false;
+            const bool on_the_fly_coefficients = false;
             const RealVect cdx{AMREX_D_DECL(cgeom->CellSize(0), cgeom->CellSize(1), cgeom->CellSize(2))};
             // Get the cell-centered box, with guard cells
             BoxArray realspace_cba = cba; // Copy box
@@ -875,8 +882,9 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
             realspace_cba.enclosedCells().grow(nge); // cell-centered + guard cells
             spectral_solver_cp = std::make_unique<SpectralSolver>(lev, realspace_cba, cdm,
                 nox_fft, noy_fft, noz_fft, do_nodal, fill_guards, v_galilean_zero,
-                v_comoving_zero, cdx, dt, in_pml, periodic_single_box, update_with_rho,
-                fft_do_time_averaging, do_multi_J, m_dive_cleaning, m_divb_cleaning);
+                v_comoving_zero, cdx, dt, in_pml, periodic_single_box, distributed_fft, update_with_rho,
+                current_correction, fft_do_time_averaging, do_multi_J, m_dive_cleaning, m_divb_cleaning,
+                on_the_fly_coefficients);
 #endif
         }
     }
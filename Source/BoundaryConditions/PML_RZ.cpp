@@ -31,6 +31,7 @@
 
 #include <cmath>
 #include <memory>
+#include <utility>
 
 using namespace amrex;
 
@@ -183,6 +184,26 @@ PML_RZ::CheckPoint (const std::string& dir) const
     }
 }
 
+void
+PML_RZ::Remake (const amrex::BoxArray& grid_ba, const amrex::DistributionMapping& grid_dm)
+{
+    for (auto* pml_fields : {&pml_E_fp, &pml_B_fp}) {
+        for (auto& mf : *pml_fields) {
+            const amrex::BoxArray ba = amrex::convert(grid_ba, mf->ixType());
+            if (ba == mf->boxArray()) {
+                ablastr::utils::communication::Redistribute(*mf, grid_dm, true);
+            } else {
+                // The boxes were split or merged: the data is copied where the old and new boxes overlap
+                const amrex::IntVect ng = mf->nGrowVect();
+                auto new_mf = std::make_unique<amrex::MultiFab>(ba, grid_dm, mf->nComp(), ng);
+                new_mf->setVal(0.0);
+                new_mf->ParallelCopy(*mf, 0, 0, mf->nComp(), ng, ng);
+                mf = std::move(new_mf);
+            }
+        }
+    }
+}
+
 void
 PML_RZ::Restart (const std::string& dir)
 {
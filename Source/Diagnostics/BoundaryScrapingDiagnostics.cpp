@@ -10,9 +10,15 @@
 #include "Diagnostics/Diagnostics.H"
 #include "Diagnostics/FlushFormats/FlushFormat.H"
 #include "Particles/ParticleBoundaryBuffer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
 #include <AMReX.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Vector.H>
 
 #include <set>
 #include <string>
@@ -75,6 +81,14 @@ BoundaryScrapingDiagnostics::ReadParameters ()
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         m_format == "openpmd",
         error_string);
+
+    // Optionally, write the scraped particles to file (and free the buffers)
+    // whenever they exceed a given amount of memory
+    amrex::ParmParse pp_diag_name(m_diag_name);
+    queryWithParser(pp_diag_name, "max_buffer_size", m_max_buffer_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_max_buffer_size != 0,
+        m_diag_name + ".max_buffer_size must be positive (or negative to disable streaming)");
 }
 
 void
@@ -135,11 +149,23 @@ BoundaryScrapingDiagnostics::DoComputeAndPack (int /*step*/, bool /*force_flush*
 bool
 BoundaryScrapingDiagnostics::DoDump (int /*step*/, int /*i_buffer*/, bool force_flush)
 {
+    m_is_last_flush = force_flush;
     if (force_flush) {
         return true;
-    } else {
+    }
+    if (m_max_buffer_size < 0) {
         return false;
     }
+
+    // Flush when the buffers of any MPI rank exceed the threshold
+    // (all ranks take part in the file output, so they must agree)
+    ParticleBoundaryBuffer& particle_buffer = WarpX::GetInstance().GetParticleBoundaryBuffer();
+    amrex::Long bytes = 0;
+    for (auto const& species_name : m_output_species_names) {
+        bytes += particle_buffer.getNumBytesInContainer(species_name, AMREX_SPACEDIM*2);
+    }
+    amrex::ParallelAllReduce::Max(bytes, amrex::ParallelDescriptor::Communicator());
+    return bytes > m_max_buffer_size;
 }
 
 void
@@ -152,16 +178,31 @@ BoundaryScrapingDiagnostics::Flush (int i_buffer)
     //   - writing the data that was accumulated in a PinnedMemoryParticleContainer
     //   - writing repeatedly to the same file
     bool const isBTD = true;
-    // For now, because this function is currently only called at the very end
-    // of the simulation for BoundaryScrapingDiagnostics, we always set `isLastBTD`.
-    // This tells WarpX to write all the metadata (and not purely the particle data)
-    bool const isLastBTD = true;
+    // `isLastBTD` is set only for the flush at the end of the simulation.
+    // This tells WarpX to write all the metadata (and not purely the particle data);
+    // the intermediate flushes (when the buffers exceed `max_buffer_size`) append
+    // the particles to the same file.
+    bool const isLastBTD = m_is_last_flush;
     const amrex::Geometry& geom = warpx.Geom(0); // For compatibility with `WriteToFile` ; not used
+    // Every flush writes to the same iteration (not to the current step)
+    amrex::Vector<int> const iteration(warpx.getistep().size(), m_output_iteration);
 
     m_flush_format->WriteToFile(
-        m_varnames, m_mf_output[i_buffer], m_geom_output[i_buffer], warpx.getistep(),
+        m_varnames, m_mf_output[i_buffer], m_geom_output[i_buffer], iteration,
         0., m_output_species[i_buffer], nlev_output, m_file_prefix,
-        m_file_min_digits, false, false, isBTD, i_buffer, geom,
+        m_file_min_digits, false, false, isBTD, m_output_iteration, geom,
         isLastBTD, m_totalParticles_flushed_already[i_buffer]);
 
+    if (!isLastBTD) {
+        // Keep track of the particles already written, and empty the buffers
+        // (their memory is kept and reused for the next scraped particles)
+        ParticleBoundaryBuffer& particle_buffer = warpx.GetParticleBoundaryBuffer();
+        int const n_species = m_output_species_names.size();
+        for (int i_species=0; i_species<n_species; i_species++) {
+            auto const& species_name = m_output_species_names[i_species];
+            m_totalParticles_flushed_already[i_buffer][i_species] +=
+                particle_buffer.getNumParticlesInContainer(species_name, AMREX_SPACEDIM*2);
+            particle_buffer.clearParticles(species_name, AMREX_SPACEDIM*2);
+        }
+    }
 }
@@ -61,9 +61,12 @@ RhoFunctor::operator() ( amrex::MultiFab& mf_dst, const int dcomp, const int /*i
         if (WarpX::use_kspace_filter) {
             auto & solver = warpx.get_spectral_solver_fp(m_lev);
             const SpectralFieldIndex& Idx = solver.m_spectral_index;
-            solver.ForwardTransform(m_lev, *rho, Idx.rho_new);
-            solver.ApplyFilter(m_lev, Idx.rho_new);
-            solver.BackwardTransform(m_lev, *rho, Idx.rho_new);
+            // rho is not allocated in spectral space when the PSATD algorithm does not use it:
+            // use the (temporary) div(E) data instead
+            const int rho_comp = (Idx.rho_new >= 0) ? Idx.rho_new : Idx.divE;
+            solver.ForwardTransform(m_lev, *rho, rho_comp);
+            solver.ApplyFilter(m_lev, rho_comp);
+            solver.BackwardTransform(m_lev, *rho, rho_comp);
         }
     }
 #endif
@@ -647,6 +647,24 @@ FullDiagnostics::InitializeFieldFunctors (int lev)
 }
 
 
+void
+FullDiagnostics::RemakeLevels ()
+{
+    auto & warpx = WarpX::GetInstance();
+    nlev = warpx.finestLevel() + 1;
+    nlev_output = nlev;
+    for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
+        // Level 0 is never regridded
+        for (int lev = 1; lev < nmax_lev; ++lev) {
+            if (lev < nlev_output) {
+                InitializeBufferData(i_buffer, lev);
+            } else {
+                m_mf_output[i_buffer][lev].clear();
+            }
+        }
+    }
+}
+
 void
 FullDiagnostics::PrepareFieldDataForOutput ()
 {
@@ -54,6 +54,14 @@ MultiDiagnostics::InitializeFieldFunctors ( int lev )
     }
 }
 
+void
+MultiDiagnostics::RemakeLevels ()
+{
+    for( auto& diag : alldiags ){
+        diag->RemakeLevels();
+    }
+}
+
 void
 MultiDiagnostics::ReadParameters ()
 {
@@ -6,6 +6,7 @@
  */
 #include "BeamRelevant.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -13,14 +14,9 @@
 #include "Utils/WarpXConst.H"
 #include "WarpX.H"
 
-#include <AMReX_GpuQualifiers.H>
-#include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
-#include <AMReX_ParticleReduce.H>
-#include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
-#include <AMReX_Tuple.H>
 
 #include <algorithm>
 #include <cmath>
@@ -148,6 +144,17 @@ BeamRelevant::BeamRelevant (std::string rd_name)
 // end constructor
 
 // function that compute beam relevant quantities
+void BeamRelevant::RequestParticleMoments (int step, std::vector<int>& species_flags) const
+{
+    if (!m_intervals.contains(step+1)) { return; }
+
+    const auto species_names = WarpX::GetInstance().GetPartContainer().GetSpeciesNames();
+    for (int i_s = 0; i_s < static_cast<int>(species_names.size()); ++i_s)
+    {
+        if (species_names[i_s] == m_beam_name) { species_flags[i_s] |= ParticleMoments::Variance; }
+    }
+}
+
 void BeamRelevant::ComputeDiags (int step)
 {
     // Judge if the diags should be done
@@ -162,18 +169,6 @@ void BeamRelevant::ComputeDiags (int step)
     // get species names (std::vector<std::string>)
     auto const species_names = mypc.GetSpeciesNames();
 
-    // inverse of speed of light squared
-    Real constexpr inv_c2 = 1.0_rt / (PhysConst::c * PhysConst::c);
-
-    // If 2D-XZ, p.pos(1) is z, rather than p.pos(2).
-#if (defined WARPX_DIM_3D)
-    int const index_z = 2;
-#elif (defined WARPX_DIM_XZ || defined WARPX_DIM_RZ)
-    int const index_z = 1;
-#elif (defined WARPX_DIM_1D_Z)
-    int const index_z = 0;
-#endif
-
     // loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -187,70 +182,11 @@ void BeamRelevant::ComputeDiags (int step)
         ParticleReal const m = myspc.getMass();
         ParticleReal const q = myspc.getCharge();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        amrex::ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,
-        ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_ops;
-        auto r = amrex::ParticleReduce<amrex::ReduceData<ParticleReal,ParticleReal,
-        ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple
-            <ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
-            ParticleReal,ParticleReal,ParticleReal>
-            {
-                const ParticleReal p_ux = p.rdata(PIdx::ux);
-                const ParticleReal p_uy = p.rdata(PIdx::uy);
-                const ParticleReal p_uz = p.rdata(PIdx::uz);
-                const ParticleReal p_us = p_ux*p_ux + p_uy*p_uy + p_uz*p_uz;
-                const ParticleReal p_pos0 = p.pos(0);
-                const ParticleReal p_w = p.rdata(PIdx::w);
-
-#if (defined WARPX_DIM_RZ)
-                const ParticleReal p_theta = p.rdata(PIdx::theta);
-                const ParticleReal p_x_mean = p_pos0*std::cos(p_theta)*p_w;
-                const ParticleReal p_y_mean = p_pos0*std::sin(p_theta)*p_w;
-#else
-                const ParticleReal p_pos1 = p.pos(1);
-                const ParticleReal p_x_mean = p_pos0*p_w;
-                const ParticleReal p_y_mean = p_pos1*p_w;
-#endif
-                const ParticleReal p_z_mean = p.pos(index_z)*p_w;
-
-                const ParticleReal p_ux_mean = p_ux*p_w;
-                const ParticleReal p_uy_mean = p_uy*p_w;
-                const ParticleReal p_uz_mean = p_uz*p_w;
-                const ParticleReal p_gm_mean = std::sqrt(1.0_rt+p_us*inv_c2)*p_w;
+        // weighted means and central second moments of the beam
+        const SpeciesMoments& moments = (*m_particle_moments)[i_s];
+        using Q = SpeciesMoments::Quantity;
 
-                return {p_w,
-                        p_x_mean, p_y_mean, p_z_mean,
-                        p_ux_mean, p_uy_mean, p_uz_mean,
-                        p_gm_mean};
-            },
-            reduce_ops);
-
-        std::vector<ParticleReal> values_per_rank_1st = {
-            amrex::get<0>(r), // w
-            amrex::get<1>(r), // x_mean
-            amrex::get<2>(r), // y_mean
-            amrex::get<3>(r), // z_mean
-            amrex::get<4>(r), // ux_mean
-            amrex::get<5>(r), // uy_mean
-            amrex::get<6>(r), // uz_mean
-            amrex::get<7>(r), // gm_mean
-        };
-
-        // reduced sum over mpi ranks (allreduce)
-        amrex::ParallelAllReduce::Sum
-        ( values_per_rank_1st.data(), values_per_rank_1st.size(), ParallelDescriptor::Communicator());
-
-        ParticleReal w_sum   = values_per_rank_1st.at(0);
-        ParticleReal x_mean  = values_per_rank_1st.at(1) /= w_sum;
-        ParticleReal y_mean  = values_per_rank_1st.at(2) /= w_sum;
-        ParticleReal z_mean  = values_per_rank_1st.at(3) /= w_sum;
-        ParticleReal ux_mean = values_per_rank_1st.at(4) /= w_sum;
-        ParticleReal uy_mean = values_per_rank_1st.at(5) /= w_sum;
-        ParticleReal uz_mean = values_per_rank_1st.at(6) /= w_sum;
-        ParticleReal gm_mean = values_per_rank_1st.at(7) /= w_sum;
+        ParticleReal const w_sum = moments.w_sum;
 
         if (w_sum < std::numeric_limits<Real>::min() )
         {
@@ -259,96 +195,27 @@ void BeamRelevant::ComputeDiags (int step)
             return;
         }
 
-        amrex::ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,
-        ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_ops2;
-
-        auto r2 = amrex::ParticleReduce<amrex::ReduceData<ParticleReal,ParticleReal,
-        ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
-        ParticleReal,ParticleReal,ParticleReal>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple
-            <ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
-            ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal>
-            {
-                const ParticleReal p_ux = p.rdata(PIdx::ux);
-                const ParticleReal p_uy = p.rdata(PIdx::uy);
-                const ParticleReal p_uz = p.rdata(PIdx::uz);
-                const ParticleReal p_us = p_ux*p_ux + p_uy*p_uy + p_uz*p_uz;
-                const ParticleReal p_gm = std::sqrt(1.0_rt+p_us*inv_c2);
-                const ParticleReal p_w = p.rdata(PIdx::w);
-
-#if (defined WARPX_DIM_1D_Z)
-                const ParticleReal p_x = 0.0;
-                const ParticleReal p_y = 0.0;
-#elif (defined WARPX_DIM_RZ)
-                const ParticleReal p_pos0 = p.pos(0);
-                const ParticleReal p_theta = p.rdata(PIdx::theta);
-                const ParticleReal p_x = p_pos0*std::cos(p_theta);
-                const ParticleReal p_y = p_pos0*std::sin(p_theta);
-#elif (defined WARPX_DIM_XZ)
-                const ParticleReal p_pos0 = p.pos(0);
-                const ParticleReal p_x = p_pos0;
-                const ParticleReal p_y = 0.0;
-#else
-                const ParticleReal p_pos0 = p.pos(0);
-                const ParticleReal p_pos1 = p.pos(1);
-                const ParticleReal p_x = p_pos0;
-                const ParticleReal p_y = p_pos1;
-#endif
-                const ParticleReal p_z = p.pos(index_z);
-
-                const ParticleReal p_x_ms = (p_x-x_mean)*(p_x-x_mean)*p_w;
-                const ParticleReal p_y_ms = (p_y-y_mean)*(p_y-y_mean)*p_w;
-                const ParticleReal p_z_ms = (p_z-z_mean)*(p_z-z_mean)*p_w;
-
-                const ParticleReal p_ux_ms = (p_ux-ux_mean)*(p_ux-ux_mean)*p_w;
-                const ParticleReal p_uy_ms = (p_uy-uy_mean)*(p_uy-uy_mean)*p_w;
-                const ParticleReal p_uz_ms = (p_uz-uz_mean)*(p_uz-uz_mean)*p_w;
-                const ParticleReal p_gm_ms = (p_gm-gm_mean)*(p_gm-gm_mean)*p_w;
-
-                const ParticleReal p_xux = (p_x-x_mean)*(p_ux-ux_mean)*p_w;
-                const ParticleReal p_yuy = (p_y-y_mean)*(p_uy-uy_mean)*p_w;
-                const ParticleReal p_zuz = (p_z-z_mean)*(p_uz-uz_mean)*p_w;
-
-                const ParticleReal p_charge = q*p_w;
-
-                return {p_x_ms, p_y_ms, p_z_ms,
-                        p_ux_ms, p_uy_ms, p_uz_ms,
-                        p_gm_ms,
-                        p_xux, p_yuy, p_zuz,
-                        p_charge};
-            },
-            reduce_ops2);
-
-        std::vector<ParticleReal> values_per_rank_2nd = {
-            amrex::get<0>(r2), // x_ms
-            amrex::get<1>(r2), // y_ms
-            amrex::get<2>(r2), // z_ms
-            amrex::get<3>(r2), // ux_ms
-            amrex::get<4>(r2), // uy_ms
-            amrex::get<5>(r2), // uz_ms
-            amrex::get<6>(r2), // gm_ms
-            amrex::get<7>(r2), // xux
-            amrex::get<8>(r2), // yuy
-            amrex::get<9>(r2), // zuz
-            amrex::get<10>(r2) // charge
-        };
-
-        // reduced sum over mpi ranks (reduce to IO rank)
-        ParallelDescriptor::ReduceRealSum
-        ( values_per_rank_2nd.data(), values_per_rank_2nd.size(), ParallelDescriptor::IOProcessorNumber());
-
-        ParticleReal x_ms   = values_per_rank_2nd.at(0) /= w_sum;
-        ParticleReal y_ms   = values_per_rank_2nd.at(1) /= w_sum;
-        ParticleReal z_ms   = values_per_rank_2nd.at(2) /= w_sum;
-        ParticleReal ux_ms  = values_per_rank_2nd.at(3) /= w_sum;
-        ParticleReal uy_ms  = values_per_rank_2nd.at(4) /= w_sum;
-        ParticleReal uz_ms  = values_per_rank_2nd.at(5) /= w_sum;
-        ParticleReal gm_ms  = values_per_rank_2nd.at(6) /= w_sum;
-        ParticleReal xux    = values_per_rank_2nd.at(7) /= w_sum;
-        ParticleReal yuy    = values_per_rank_2nd.at(8) /= w_sum;
-        ParticleReal zuz    = values_per_rank_2nd.at(9) /= w_sum;
-        ParticleReal charge = values_per_rank_2nd.at(10);
+        ParticleReal const x_mean  = moments.mean[Q::x];
+        ParticleReal const y_mean  = moments.mean[Q::y];
+        ParticleReal const z_mean  = moments.mean[Q::z];
+        ParticleReal const ux_mean = moments.mean[Q::ux];
+        ParticleReal const uy_mean = moments.mean[Q::uy];
+        ParticleReal const uz_mean = moments.mean[Q::uz];
+        ParticleReal const gm_mean = moments.mean[Q::gamma];
+
+        ParticleReal const x_ms  = moments.variance[Q::x];
+        ParticleReal const y_ms  = moments.variance[Q::y];
+        ParticleReal const z_ms  = moments.variance[Q::z];
+        ParticleReal const ux_ms = moments.variance[Q::ux];
+        ParticleReal const uy_ms = moments.variance[Q::uy];
+        ParticleReal const uz_ms = moments.variance[Q::uz];
+        ParticleReal const gm_ms = moments.variance[Q::gamma];
+
+        ParticleReal const xux = moments.correlation[0];
+        ParticleReal const yuy = moments.correlation[1];
+        ParticleReal const zuz = moments.correlation[2];
+
+        ParticleReal const charge = q*w_sum;
 
         // save data
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
@@ -32,12 +32,22 @@
 #include <AMReX_RealVect.H>
 #include <AMReX_Reduce.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_StructOfArrays.H>
 #include <AMReX_Vector.H>
 
+#if defined(AMREX_USE_MPI)
+#   include <mpi.h>
+#endif
+
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <ostream>
 #include <string>
@@ -154,6 +164,15 @@ FieldProbe::FieldProbe (std::string rd_name)
     pp_rd_name.query("interp_order", interp_order);
     pp_rd_name.query("do_moving_window_FP", do_moving_window_FP);
 
+    std::string output_format = "text";
+    pp_rd_name.query("output_format", output_format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(output_format == "text" || output_format == "binary",
+        "FieldProbe output_format must be either text or binary");
+    m_binary_output = (output_format == "binary");
+    queryWithParser(pp_rd_name, "buffer_size", m_buffer_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_buffer_size > 0,
+        "FieldProbe buffer_size must be a positive integer");
+
     if (WarpX::gamma_boost > 1.0_rt)
     {
         ablastr::warn_manager::WMRecordWarning(
@@ -232,6 +251,12 @@ FieldProbe::FieldProbe (std::string rd_name)
 
             // close file
             ofs.close();
+
+            // the values of a binary probe are written to a separate file
+            if (m_binary_output)
+            {
+                std::ofstream ofs_bin{m_path + m_rd_name + ".bin", std::ofstream::trunc};
+            }
         }
     }
 } // end constructor
@@ -387,6 +412,26 @@ void FieldProbe::ComputeDiags (int step)
     // get number of mesh-refinement levels
     const auto nLevel = warpx.finestLevel() + 1;
 
+    if (m_intervals.contains(step+1) && ProbeInDomain())
+    {
+        // register a new buffered output step (its points are added below, on all levels)
+        if (m_buffer_steps.empty())
+        {
+            long npoints = 0;
+            for (int lev = 0; lev < nLevel; ++lev)
+            {
+                for (FieldProbeParticleContainer::iterator pti(m_probe, lev); pti.isValid(); ++pti)
+                {
+                    npoints += pti.numParticles();
+                }
+            }
+            m_buffer.reserve(m_buffer_size * npoints * noutputs);
+        }
+        m_buffer_steps.push_back(step);
+        m_buffer_times.push_back(warpx.gett_new(0));
+        m_buffer_npoints.push_back(0);
+    }
+
     // loop over refinement levels
     for (int lev = 0; lev < nLevel; ++lev)
     {
@@ -424,24 +469,9 @@ void FieldProbe::ComputeDiags (int step)
         amrex::IndexType const Bytype = By.ixType();
         amrex::IndexType const Bztype = Bz.ixType();
 
-        // loop over each particle
-        // TODO: add OMP parallel as in PhysicalParticleContainer::Evolve
-        long numparticles = 0; // particles on this MPI rank
-        using MyParIter = FieldProbeParticleContainer::iterator;
-        for (MyParIter pti(m_probe, lev); pti.isValid(); ++pti)
-        {
-            // count particle on MPI rank
-            numparticles += pti.numParticles();
-        }
-
-        if (m_intervals.contains(step+1))
-        {
-            // reset m_data vector to clear pushed values. Reserves data
-            m_data.clear();
-            m_data.shrink_to_fit();
-            m_data.reserve(numparticles * noutputs);
-        }
+        bool const do_output = m_intervals.contains(step+1) && ProbeInDomain();
 
+        using MyParIter = FieldProbeParticleContainer::iterator;
         for (MyParIter pti(m_probe, lev); pti.isValid(); ++pti)
         {
             const auto getPosition = GetParticlePosition(pti);
@@ -581,106 +611,200 @@ void FieldProbe::ComputeDiags (int step)
                     }
                 });// ParallelFor Close
                 // this check is here because for m_field_probe_integrate == True, we always compute
-                // but we only write when we truly are in an output interval step
-                if (m_intervals.contains(step+1))
+                // but we only buffer the values when we truly are in an output interval step
+                if (do_output)
                 {
-                    for (auto ip=0; ip < np; ip++)
+                    // append the values of this tile to the buffer, on the device
+                    auto const offset = m_buffer.size();
+                    m_buffer.resize(offset + np*noutputs);
+                    amrex::Real* const AMREX_RESTRICT buf = m_buffer.dataPtr() + offset;
+                    amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (long ip)
                     {
                         amrex::ParticleReal xp, yp, zp;
                         getPosition(ip, xp, yp, zp);
 
-                        // push to output vector
-                        m_data.push_back(xp);
-                        m_data.push_back(yp);
-                        m_data.push_back(zp);
-                        m_data.push_back(part_Ex[ip]);
-                        m_data.push_back(part_Ey[ip]);
-                        m_data.push_back(part_Ez[ip]);
-                        m_data.push_back(part_Bx[ip]);
-                        m_data.push_back(part_By[ip]);
-                        m_data.push_back(part_Bz[ip]);
-                        m_data.push_back(part_S[ip]);
-                    }
-                /* m_data now contains up-to-date values for:
-                 *  [x, y, z, Ex, Ey, Ez, Bx, By, Bz, and S] */
+                        amrex::Real* const AMREX_RESTRICT row = buf + ip*noutputs;
+                        row[0] = xp;
+                        row[1] = yp;
+                        row[2] = zp;
+                        row[3] = part_Ex[ip];
+                        row[4] = part_Ey[ip];
+                        row[5] = part_Ez[ip];
+                        row[6] = part_Bx[ip];
+                        row[7] = part_By[ip];
+                        row[8] = part_Bz[ip];
+                        row[9] = part_S[ip];
+                    });
+                    /* the buffer now contains up-to-date values for:
+                     *  [x, y, z, Ex, Ey, Ez, Bx, By, Bz, and S] */
+                    m_buffer_npoints.back() += static_cast<int>(np);
                 }
             }
         } // end particle iterator loop
-        Gpu::synchronize();
-        if (m_intervals.contains(step+1))
-        {
-            // returns total number of mpi notes into mpisize
-            int mpisize = ParallelDescriptor::NProcs();
-
-            // allocates data space for length_array. Will contain size of m_data from each processor
-            amrex::Vector<int> length_vector;
-            amrex::Vector<int> localsize;
-
-            if (amrex::ParallelDescriptor::IOProcessor()) {
-                length_vector.resize(mpisize, 0);
-            }
-            localsize.resize(1, m_data.size());
-
-            // gather size of m_data from each processor
-            amrex::ParallelDescriptor::Gather(localsize.data(), 1,
-                                              length_vector.data(), 1,
-                                              amrex::ParallelDescriptor::IOProcessorNumber());
-
-            // IO processor sums values from length_array to get size of total output array.
-            /* displs records the size of each m_data as well as previous displs. This array
-             * tells Gatherv where in the m_data_out array allocation to write incomming data. */
-            long total_data_size = 0;
-            amrex::Vector<int> displs_vector;
-            if (amrex::ParallelDescriptor::IOProcessor()) {
-                displs_vector.resize(mpisize, 0);
-                displs_vector[0] = 0;
-                total_data_size += length_vector[0];
-                for (int i=1; i<mpisize; i++) {
-                    displs_vector[i] = (displs_vector[i-1] + length_vector[i-1]);
-                    total_data_size += length_vector[i];
-                }
-                // valid particles are counted (for all MPI ranks) to inform output processes as to size of output
-                m_valid_particles = total_data_size / noutputs;
-                m_data_out.resize(total_data_size, 0);
-            }
-            // resize receive buffer (resize, initialize 0)
-            // gather m_data of varied lengths from all processors. Prints to m_data_out
-            amrex::ParallelDescriptor::Gatherv(m_data.data(), localsize[0],
-                                               m_data_out.data(), length_vector, displs_vector,
-                                               amrex::ParallelDescriptor::IOProcessorNumber());
-        }
     }// end loop over refinement levels
-    // make sure data is in m_data on the IOProcessor
-    // TODO: In the future, we want to use a parallel I/O method instead (plotfiles or openPMD)
+
+    if (m_intervals.contains(step+1) && ProbeInDomain())
+    {
+        // write out once enough output steps are buffered
+        if (static_cast<int>(m_buffer_steps.size()) >= m_buffer_size) { Flush(); }
+    }
     m_last_compute_step = step;
 } // end void FieldProbe::ComputeDiags
 
-void FieldProbe::WriteToFile (int step) const
+void FieldProbe::Flush ()
 {
-    if (ProbeInDomain() && amrex::ParallelDescriptor::IOProcessor())
-    {
-        // open file
-        std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-                          std::ofstream::out | std::ofstream::app};
+    if (m_buffer_steps.empty()) { return; }
 
-        // loop over num valid particles and write
-        for (int i = 0; i < m_valid_particles; i++)
+    // single copy of all buffered steps to the host
+    amrex::Vector<amrex::Real> buffer(m_buffer.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost, m_buffer.begin(), m_buffer.end(), buffer.begin());
+    amrex::Gpu::streamSynchronize();
+
+    if (m_binary_output) {
+        WriteBinary(buffer);
+    } else {
+        WriteText(buffer);
+    }
+
+    m_buffer.clear();
+    m_buffer_steps.clear();
+    m_buffer_times.clear();
+    m_buffer_npoints.clear();
+}
+
+void FieldProbe::WriteText (amrex::Vector<amrex::Real> const & buffer) const
+{
+    int const nsteps = static_cast<int>(m_buffer_steps.size());
+    int const mpisize = ParallelDescriptor::NProcs();
+    int const ioproc = ParallelDescriptor::IOProcessorNumber();
+
+    // gather the number of points of each rank for each buffered step
+    amrex::Vector<int> npoints_all;
+    if (ParallelDescriptor::IOProcessor()) { npoints_all.resize(mpisize*nsteps, 0); }
+    ParallelDescriptor::Gather(m_buffer_npoints.data(), nsteps, npoints_all.data(), nsteps, ioproc);
+
+    // gather the buffers of all ranks, in one message per rank
+    amrex::Vector<int> length_vector, displs_vector;
+    amrex::Vector<amrex::Real> data_out;
+    if (ParallelDescriptor::IOProcessor())
+    {
+        length_vector.resize(mpisize, 0);
+        displs_vector.resize(mpisize, 0);
+        for (int i = 0; i < mpisize; ++i)
         {
-            ofs << std::fixed << std::defaultfloat;
-            ofs << step + 1;
-            ofs << m_sep;
-            ofs << std::fixed << std::setprecision(14) << std::scientific;
-            // write time
-            ofs << WarpX::GetInstance().gett_new(0);
+            for (int k = 0; k < nsteps; ++k) { length_vector[i] += npoints_all[i*nsteps+k]*noutputs; }
+            if (i > 0) { displs_vector[i] = displs_vector[i-1] + length_vector[i-1]; }
+        }
+        data_out.resize(displs_vector[mpisize-1] + length_vector[mpisize-1]);
+    }
+    ParallelDescriptor::Gatherv(buffer.data(), static_cast<int>(buffer.size()),
+                                data_out.data(), length_vector, displs_vector, ioproc);
+
+    if (!ParallelDescriptor::IOProcessor()) { return; }
+
+    // open file
+    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
+                      std::ofstream::out | std::ofstream::app};
+
+    // position of the next row of each rank in data_out
+    amrex::Vector<long> next_row(displs_vector.begin(), displs_vector.end());
 
-            for (int k = 0; k < noutputs; k++)
+    // write one line per probe point, step by step
+    for (int k = 0; k < nsteps; ++k)
+    {
+        for (int i = 0; i < mpisize; ++i)
+        {
+            for (int ip = 0; ip < npoints_all[i*nsteps+k]; ++ip)
             {
+                ofs << std::fixed << std::defaultfloat;
+                ofs << m_buffer_steps[k] + 1;
                 ofs << m_sep;
-                ofs << m_data_out[i * noutputs + k];
+                ofs << std::fixed << std::setprecision(14) << std::scientific;
+                // write time
+                ofs << m_buffer_times[k];
+
+                for (int c = 0; c < noutputs; ++c)
+                {
+                    ofs << m_sep;
+                    ofs << data_out[next_row[i] + c];
+                }
+                ofs << '\n';
+                next_row[i] += noutputs;
             }
-            ofs << std::endl;
-        } // end loop over data size
+        }
+    }
     // close file
     ofs.close();
+}
+
+void FieldProbe::WriteBinary (amrex::Vector<amrex::Real> const & buffer) const
+{
+    int const nsteps = static_cast<int>(m_buffer_steps.size());
+    std::string const filename = m_path + m_rd_name + ".bin";
+
+    // size of the record header: step, time and number of points
+    constexpr std::size_t header_size = sizeof(std::int64_t) + sizeof(double) + sizeof(std::int64_t);
+    std::size_t const point_size = noutputs*sizeof(amrex::Real);
+
+    // first point of this rank and total number of points, for each buffered step
+    amrex::Vector<long long> npoints(m_buffer_npoints.begin(), m_buffer_npoints.end());
+    amrex::Vector<long long> first_point(nsteps, 0);
+    amrex::Vector<long long> total_points(npoints);
+
+#if defined(AMREX_USE_MPI)
+    MPI_Comm const comm = ParallelDescriptor::Communicator();
+    MPI_Exscan(npoints.data(), first_point.data(), nsteps, MPI_LONG_LONG, MPI_SUM, comm);
+    if (ParallelDescriptor::MyProc() == 0) { std::fill(first_point.begin(), first_point.end(), 0); }
+    MPI_Allreduce(npoints.data(), total_points.data(), nsteps, MPI_LONG_LONG, MPI_SUM, comm);
+
+    MPI_File fh;
+    MPI_File_open(comm, filename.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh);
+    MPI_Offset record_offset = 0;
+    MPI_File_get_size(fh, &record_offset);
+
+    MPI_Datatype const real_type = ParallelDescriptor::Mpi_typemap<amrex::Real>::type();
+    long data_offset = 0;
+    for (int k = 0; k < nsteps; ++k)
+    {
+        // the I/O rank writes the record header
+        if (ParallelDescriptor::IOProcessor())
+        {
+            char header[header_size];
+            std::int64_t const step = m_buffer_steps[k] + 1;
+            double const time = m_buffer_times[k];
+            std::int64_t const n = total_points[k];
+            std::memcpy(header, &step, sizeof(step));
+            std::memcpy(header + sizeof(step), &time, sizeof(time));
+            std::memcpy(header + sizeof(step) + sizeof(time), &n, sizeof(n));
+            MPI_File_write_at(fh, record_offset, header, static_cast<int>(header_size),
+                              MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+
+        // all ranks write their points of this step at once
+        MPI_Offset const offset = record_offset
+            + static_cast<MPI_Offset>(header_size + first_point[k]*point_size);
+        MPI_File_write_at_all(fh, offset, buffer.data() + data_offset,
+                              static_cast<int>(npoints[k]*noutputs), real_type, MPI_STATUS_IGNORE);
+
+        record_offset += static_cast<MPI_Offset>(header_size + total_points[k]*point_size);
+        data_offset += npoints[k]*noutputs;
     }
+    MPI_File_close(&fh);
+#else
+    std::ofstream ofs{filename, std::ofstream::out | std::ofstream::app | std::ofstream::binary};
+    long data_offset = 0;
+    for (int k = 0; k < nsteps; ++k)
+    {
+        std::int64_t const step = m_buffer_steps[k] + 1;
+        double const time = m_buffer_times[k];
+        std::int64_t const n = total_points[k];
+        ofs.write(reinterpret_cast<char const*>(&step), sizeof(step));
+        ofs.write(reinterpret_cast<char const*>(&time), sizeof(time));
+        ofs.write(reinterpret_cast<char const*>(&n), sizeof(n));
+        ofs.write(reinterpret_cast<char const*>(buffer.data() + data_offset),
+                  static_cast<std::streamsize>(n*point_size));
+        data_offset += n*noutputs;
+    }
+    amrex::ignore_unused(first_point, header_size);
+#endif
 }
@@ -19,10 +19,12 @@
 #include "ParticleHistogram.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
+#include "Particles/MultiParticleContainer.H"
 #include "RhoMaximum.H"
 #include "Utils/IntervalsParser.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
 
 #include <AMReX.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -33,6 +35,7 @@
 #include <functional>
 #include <iterator>
 #include <map>
+#include <vector>
 
 using namespace amrex;
 
@@ -81,6 +84,10 @@ MultiReducedDiags::MultiReducedDiags ()
             return reduced_diags_dictionary.at(rd_type)(rd_name);
         });
     // end loop over all reduced diags
+
+    for (auto& rd : m_multi_rd) {
+        rd->m_particle_moments = &m_particle_moments;
+    }
 }
 // end constructor
 
@@ -106,6 +113,17 @@ void MultiReducedDiags::ComputeDiags (int step)
 {
     WARPX_PROFILE("MultiReducedDiags::ComputeDiags()");
 
+    // compute the particle moments used by any reduced diags at this step,
+    // in a single pass over the particles of each species
+    const int nSpecies = WarpX::GetInstance().GetPartContainer().nSpecies();
+    std::vector<int> species_flags(nSpecies, 0);
+    for (const auto& rd : m_multi_rd) {
+        rd->RequestParticleMoments(step, species_flags);
+    }
+    if (std::any_of(species_flags.begin(), species_flags.end(), [](int f){ return f != 0; })) {
+        m_particle_moments.Compute(species_flags);
+    }
+
     // loop over all reduced diags
     for (int i_rd = 0; i_rd < static_cast<int>(m_rd_names.size()); ++i_rd)
     {
@@ -133,3 +151,10 @@ void MultiReducedDiags::WriteToFile (int step)
     // end loop over all reduced diags
 }
 // end void MultiReducedDiags::WriteToFile
+
+void MultiReducedDiags::Flush ()
+{
+    for (auto& rd : m_multi_rd) {
+        rd->Flush();
+    }
+}
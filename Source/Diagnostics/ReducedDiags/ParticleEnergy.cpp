@@ -7,22 +7,14 @@
 
 #include "ParticleEnergy.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
-#include "Particles/Algorithms/KineticEnergy.H"
 #include "Particles/MultiParticleContainer.H"
-#include "Particles/SpeciesPhysicalProperties.H"
-#include "Particles/WarpXParticleContainer.H"
 #include "Utils/IntervalsParser.H"
 #include "WarpX.H"
 
-#include <AMReX_GpuQualifiers.H>
-#include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
-#include <AMReX_ParticleReduce.H>
-#include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
-#include <AMReX_Reduce.H>
-#include <AMReX_Tuple.H>
 #include <AMReX_Vector.H>
 
 #include <algorithm>
@@ -86,6 +78,13 @@ ParticleEnergy::ParticleEnergy (std::string rd_name)
     }
 }
 
+void ParticleEnergy::RequestParticleMoments (int step, std::vector<int>& species_flags) const
+{
+    if (m_intervals.contains(step+1) == false) { return; }
+
+    for (auto& flags : species_flags) { flags |= ParticleMoments::Energy; }
+}
+
 void ParticleEnergy::ComputeDiags (int step)
 {
     // Check if the diags should be done
@@ -108,62 +107,11 @@ void ParticleEnergy::ComputeDiags (int step)
     // Loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
-        // Get WarpXParticleContainer class object
-        const auto & myspc = mypc.GetParticleContainer(i_s);
-
-        // Get mass (used only for particles other than photons, see below)
-        amrex::Real m = myspc.getMass();
-
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        amrex::Real Etot = 0.0_rt;
-        amrex::Real Ws   = 0.0_rt;
-
-        // Use amrex::ParticleReduce to compute the sum of energies and weights of all particles
-        // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
-        // the result r is the tuple (Etot, Ws)
-        amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops;
-        if(myspc.AmIA<PhysicalSpecies::photon>())
-        {
-            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    return {w*Algorithms::KineticEnergyPhotons(ux,uy,uz),w};
-                },
-                reduce_ops);
-
-            Etot = amrex::get<0>(r);
-            Ws   = amrex::get<1>(r);
-        }
-        else // particle other than photons
-        {
-            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-
-                    return {w*Algorithms::KineticEnergy(ux,uy,uz,m), w};
-                },
-                reduce_ops);
-
-            Etot = amrex::get<0>(r);
-            Ws   = amrex::get<1>(r);
-        }
-
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum(Etot, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Ws  , ParallelDescriptor::IOProcessorNumber());
+        // Sum of the energies and of the weights of this species
+        const amrex::Real Etot = (*m_particle_moments)[i_s].energy_sum;
+        const amrex::Real Ws   = (*m_particle_moments)[i_s].w_sum;
 
-        // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
+        // Accumulate sum of weights over all species
         Wtot += Ws;
 
         // Save results for this species i_s into m_data
@@ -7,6 +7,7 @@
 
 #include "ParticleExtrema.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #if (defined WARPX_QED)
 #   include "Particles/ElementaryProcess/QEDInternals/QedChiFunctions.H"
@@ -37,7 +38,6 @@
 #include <AMReX_ParIter.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
-#include <AMReX_ParticleReduce.H>
 #include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Reduce.H>
@@ -162,6 +162,17 @@ ParticleExtrema::ParticleExtrema (std::string rd_name)
 }
 // end constructor
 
+void ParticleExtrema::RequestParticleMoments (int step, std::vector<int>& species_flags) const
+{
+    if (!m_intervals.contains(step+1)) { return; }
+
+    const auto species_names = WarpX::GetInstance().GetPartContainer().GetSpeciesNames();
+    for (int i_s = 0; i_s < static_cast<int>(species_names.size()); ++i_s)
+    {
+        if (species_names[i_s] == m_species_name) { species_flags[i_s] |= ParticleMoments::Extrema; }
+    }
+}
+
 // function that computes extrema
 void ParticleExtrema::ComputeDiags (int step)
 {
@@ -177,18 +188,6 @@ void ParticleExtrema::ComputeDiags (int step)
     // get species names (std::vector<std::string>)
     const auto species_names = mypc.GetSpeciesNames();
 
-    // inverse of speed of light squared
-    Real constexpr inv_c2 = 1.0_rt / (PhysConst::c * PhysConst::c);
-
-    // If 2D-XZ, p.pos(1) is z, rather than p.pos(2).
-#if (defined WARPX_DIM_3D)
-    int const index_z = 2;
-#elif (defined WARPX_DIM_XZ || defined WARPX_DIM_RZ)
-    int const index_z = 1;
-#elif (defined WARPX_DIM_1D_Z)
-    int const index_z = 0;
-#endif
-
     // loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -205,177 +204,9 @@ void ParticleExtrema::ComputeDiags (int step)
             m = PhysConst::m_e;
         }
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        // xmin
-#if (defined WARPX_DIM_RZ)
-        Real xmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0)*std::cos(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMin(xmin);
-#elif (defined WARPX_DIM_1D_Z)
-        Real xmin = 0.0_rt;
-#else
-        Real xmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0); });
-        ParallelDescriptor::ReduceRealMin(xmin);
-#endif
-
-        // xmax
-#if (defined WARPX_DIM_RZ)
-        Real xmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0)*std::cos(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMax(xmax);
-#elif (defined WARPX_DIM_1D_Z)
-        Real xmax = 0.0_rt;
-#else
-        Real xmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0); });
-        ParallelDescriptor::ReduceRealMax(xmax);
-#endif
-
-        // ymin
-#if (defined WARPX_DIM_RZ)
-        Real ymin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0)*std::sin(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMin(ymin);
-#elif (defined WARPX_DIM_XZ || WARPX_DIM_1D_Z)
-        Real ymin = 0.0_rt;
-#else
-        Real ymin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(1); });
-        ParallelDescriptor::ReduceRealMin(ymin);
-#endif
-
-        // ymax
-#if (defined WARPX_DIM_RZ)
-        Real ymax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0)*std::sin(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMax(ymax);
-#elif (defined WARPX_DIM_XZ || WARPX_DIM_1D_Z)
-        Real ymax = 0.0_rt;
-#else
-        Real ymax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(1); });
-        ParallelDescriptor::ReduceRealMax(ymax);
-#endif
-
-        // zmin
-        Real zmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(index_z); });
-        ParallelDescriptor::ReduceRealMin(zmin);
-
-        // zmax
-        Real zmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(index_z); });
-        ParallelDescriptor::ReduceRealMax(zmax);
-
-        // uxmin
-        Real uxmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::ux); });
-        ParallelDescriptor::ReduceRealMin(uxmin);
-
-        // uxmax
-        Real uxmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::ux); });
-        ParallelDescriptor::ReduceRealMax(uxmax);
-
-        // uymin
-        Real uymin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::uy); });
-        ParallelDescriptor::ReduceRealMin(uymin);
-
-        // uymax
-        Real uymax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::uy); });
-        ParallelDescriptor::ReduceRealMax(uymax);
-
-        // uzmin
-        Real uzmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::uz); });
-        ParallelDescriptor::ReduceRealMin(uzmin);
-
-        // uzmax
-        Real uzmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::uz); });
-        ParallelDescriptor::ReduceRealMax(uzmax);
-
-        // gmin
-        Real gmin = 0.0_rt;
-        if ( is_photon ) {
-            gmin = ReduceMin( myspc,
-            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                Real ux = p.rdata(PIdx::ux);
-                Real uy = p.rdata(PIdx::uy);
-                Real uz = p.rdata(PIdx::uz);
-                Real us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(us*inv_c2);
-            });
-        } else {
-            gmin = ReduceMin( myspc,
-            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                Real ux = p.rdata(PIdx::ux);
-                Real uy = p.rdata(PIdx::uy);
-                Real uz = p.rdata(PIdx::uz);
-                Real us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(1.0_rt + us*inv_c2);
-            });
-        }
-        ParallelDescriptor::ReduceRealMin(gmin);
-
-        // gmax
-        Real gmax = 0.0_rt;
-        if ( is_photon ) {
-            gmax = ReduceMax( myspc,
-            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                Real ux = p.rdata(PIdx::ux);
-                Real uy = p.rdata(PIdx::uy);
-                Real uz = p.rdata(PIdx::uz);
-                Real us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(us*inv_c2);
-            });
-        } else {
-            gmax = ReduceMax( myspc,
-            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                Real ux = p.rdata(PIdx::ux);
-                Real uy = p.rdata(PIdx::uy);
-                Real uz = p.rdata(PIdx::uz);
-                Real us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(1.0_rt + us*inv_c2);
-            });
-        }
-        ParallelDescriptor::ReduceRealMax(gmax);
-
-        // wmin
-        Real wmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::w); });
-        ParallelDescriptor::ReduceRealMin(wmin);
-
-        // wmax
-        Real wmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::w); });
-        ParallelDescriptor::ReduceRealMax(wmax);
+        // extrema of the positions, momenta, Lorentz factors and weights
+        const SpeciesMoments& moments = (*m_particle_moments)[i_s];
+        using Q = SpeciesMoments::Quantity;
 
 #if (defined WARPX_QED)
         // get number of level (int)
@@ -487,22 +318,32 @@ void ParticleExtrema::ComputeDiags (int step)
             ParallelDescriptor::ReduceRealMax(chimax_f);
         }
 #endif
-        m_data[0]  = xmin;
-        m_data[1]  = xmax;
-        m_data[2]  = ymin;
-        m_data[3]  = ymax;
-        m_data[4]  = zmin;
-        m_data[5]  = zmax;
-        m_data[6]  = uxmin*m;
-        m_data[7]  = uxmax*m;
-        m_data[8]  = uymin*m;
-        m_data[9]  = uymax*m;
-        m_data[10] = uzmin*m;
-        m_data[11] = uzmax*m;
-        m_data[12] = gmin;
-        m_data[13] = gmax;
-        m_data[14] = wmin;
-        m_data[15] = wmax;
+#if (defined WARPX_DIM_1D_Z)
+        m_data[0]  = 0.0_rt;
+        m_data[1]  = 0.0_rt;
+#else
+        m_data[0]  = moments.min[Q::x];
+        m_data[1]  = moments.max[Q::x];
+#endif
+#if (defined WARPX_DIM_XZ || defined WARPX_DIM_1D_Z)
+        m_data[2]  = 0.0_rt;
+        m_data[3]  = 0.0_rt;
+#else
+        m_data[2]  = moments.min[Q::y];
+        m_data[3]  = moments.max[Q::y];
+#endif
+        m_data[4]  = moments.min[Q::z];
+        m_data[5]  = moments.max[Q::z];
+        m_data[6]  = moments.min[Q::ux]*m;
+        m_data[7]  = moments.max[Q::ux]*m;
+        m_data[8]  = moments.min[Q::uy]*m;
+        m_data[9]  = moments.max[Q::uy]*m;
+        m_data[10] = moments.min[Q::uz]*m;
+        m_data[11] = moments.max[Q::uz]*m;
+        m_data[12] = moments.min[Q::gamma];
+        m_data[13] = moments.max[Q::gamma];
+        m_data[14] = moments.w_min;
+        m_data[15] = moments.w_max;
 #if (defined WARPX_QED)
         if (myspc.DoQED())
         {
@@ -23,13 +23,16 @@
 #include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuContainers.H>
 #include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuMemory.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_Math.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParIter.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Parser.H>
 #include <AMReX_REAL.H>
 
 #include <algorithm>
@@ -37,6 +40,7 @@
 #include <limits>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <vector>
 
 using namespace amrex;
@@ -50,6 +54,62 @@ struct NormalizationType {
     };
 };
 
+namespace
+{
+    /** Adds a particle to the bins of all histograms */
+    struct HistogramFiller
+    {
+        GetParticlePosition GetPosition;
+        const ParticleReal* w = nullptr;
+        const ParticleReal* ux = nullptr;
+        const ParticleReal* uy = nullptr;
+        const ParticleReal* uz = nullptr;
+
+        const amrex::ParserExecutor<ParticleHistogram::m_nvars>* fun = nullptr;
+        int nhist = 0;
+        const int* bin_num = nullptr;
+        const int* bin_offset = nullptr;
+        const Real* bin_min = nullptr;
+        const Real* bin_size = nullptr;
+
+        amrex::ParserExecutor<ParticleHistogram::m_nvars> filter;
+        bool do_filter = false;
+        bool unity_weight = false;
+        Real t = 0.0_rt;
+
+        /** Add particle i to the histograms in hist, with or without atomics */
+        template <bool atomic>
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        void operator() (long i, Real* hist) const noexcept
+        {
+            amrex::ParticleReal x, y, z;
+            GetPosition(i, x, y, z);
+            auto const pw  = unity_weight ? 1.0_rt : (amrex::Real)w[i];
+            auto const pux = ux[i] / PhysConst::c;
+            auto const puy = uy[i] / PhysConst::c;
+            auto const puz = uz[i] / PhysConst::c;
+
+            // don't count a particle if it is filtered out
+            if (do_filter && !filter(t, x, y, z, pux, puy, puz)) return;
+
+            for (int h = 0; h < nhist; ++h)
+            {
+                auto const f = fun[h](t, x, y, z, pux, puy, puz);
+                // determine particle bin
+                int const bin = int(Math::floor((f-bin_min[h])/bin_size[h]));
+                if ( bin<0 || bin>=bin_num[h] ) continue; // discard if out-of-range
+
+                // add particle to histogram bin
+                if constexpr (atomic) {
+                    amrex::HostDevice::Atomic::Add(&hist[bin_offset[h] + bin], pw);
+                } else {
+                    hist[bin_offset[h] + bin] += pw;
+                }
+            }
+        }
+    };
+}
+
 // constructor
 ParticleHistogram::ParticleHistogram (std::string rd_name)
 : ReducedDiags{rd_name}
@@ -60,18 +120,41 @@ ParticleHistogram::ParticleHistogram (std::string rd_name)
     std::string selected_species_name;
     pp_rd_name.get("species",selected_species_name);
 
-    // read bin parameters
-    getWithParser(pp_rd_name, "bin_number",m_bin_num);
-    getWithParser(pp_rd_name, "bin_max",   m_bin_max);
-    getWithParser(pp_rd_name, "bin_min",   m_bin_min);
-    m_bin_size = (m_bin_max - m_bin_min) / m_bin_num;
+    // read the names of the histograms computed together, if more than one;
+    // a single histogram reads its parameters directly under rd_name
+    pp_rd_name.queryarr("histogram_names", m_histogram_names);
+    std::vector<std::string> prefixes;
+    if (m_histogram_names.empty()) {
+        prefixes.push_back("");
+    } else {
+        for (auto const& name : m_histogram_names) { prefixes.push_back(name + "."); }
+    }
 
-    // read histogram function
-    std::string function_string = "";
-    Store_parserString(pp_rd_name,"histogram_function(t,x,y,z,ux,uy,uz)",
-                       function_string);
-    m_parser = std::make_unique<amrex::Parser>(
-        makeParser(function_string,{"t","x","y","z","ux","uy","uz"}));
+    int n_bins_total = 0;
+    for (auto const& prefix : prefixes)
+    {
+        // read bin parameters
+        int bin_num;
+        Real bin_max, bin_min;
+        getWithParser(pp_rd_name, (prefix + "bin_number").c_str(), bin_num);
+        getWithParser(pp_rd_name, (prefix + "bin_max").c_str(),    bin_max);
+        getWithParser(pp_rd_name, (prefix + "bin_min").c_str(),    bin_min);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(bin_num > 0,
+            "ParticleHistogram bin_number must be positive");
+        m_bin_num.push_back(bin_num);
+        m_bin_max.push_back(bin_max);
+        m_bin_min.push_back(bin_min);
+        m_bin_size.push_back((bin_max - bin_min) / bin_num);
+        m_bin_offset.push_back(n_bins_total);
+        n_bins_total += bin_num;
+
+        // read histogram function
+        std::string function_string = "";
+        Store_parserString(pp_rd_name, prefix + "histogram_function(t,x,y,z,ux,uy,uz)",
+                           function_string);
+        m_parser.push_back(std::make_unique<amrex::Parser>(
+            makeParser(function_string,{"t","x","y","z","ux","uy","uz"})));
+    }
 
     // read normalization type
     std::string norm_string = "default";
@@ -118,8 +201,8 @@ ParticleHistogram::ParticleHistogram (std::string rd_name)
                                      makeParser(filter_string,{"t","x","y","z","ux","uy","uz"}));
     }
 
-    // resize data array
-    m_data.resize(m_bin_num,0.0_rt);
+    // resize data array (the bins of all histograms, one after the other)
+    m_data.resize(n_bins_total,0.0_rt);
 
     if (ParallelDescriptor::IOProcessor())
     {
@@ -133,13 +216,17 @@ ParticleHistogram::ParticleHistogram (std::string rd_name)
             ofs << "[" << c++ << "]step()";
             ofs << m_sep;
             ofs << "[" << c++ << "]time(s)";
-            for (int i = 0; i < m_bin_num; ++i)
+            for (int h = 0; h < static_cast<int>(m_bin_num.size()); ++h)
             {
-                ofs << m_sep;
-                ofs << "[" << c++ << "]";
-                Real b = m_bin_min + m_bin_size*(Real(i)+0.5_rt);
-                ofs << "bin" + std::to_string(1+i)
-                             + "=" + std::to_string(b) + "()";
+                std::string const name = m_histogram_names.empty() ? "" : m_histogram_names[h] + "_";
+                for (int i = 0; i < m_bin_num[h]; ++i)
+                {
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]";
+                    Real b = m_bin_min[h] + m_bin_size[h]*(Real(i)+0.5_rt);
+                    ofs << name + "bin" + std::to_string(1+i)
+                                + "=" + std::to_string(b) + "()";
+                }
             }
             ofs << std::endl;
             // close file
@@ -167,115 +254,170 @@ void ParticleHistogram::ComputeDiags (int step)
     // get WarpXParticleContainer class object
     auto & myspc = mypc.GetParticleContainer(m_selected_species_id);
 
-    // get parser
-    auto fun_partparser = compileParser<m_nvars>(m_parser.get());
+    // get parsers
+    int const nhist = static_cast<int>(m_parser.size());
+    amrex::Gpu::HostVector<amrex::ParserExecutor<m_nvars>> h_fun_partparser(nhist);
+    for (int h = 0; h < nhist; ++h) {
+        h_fun_partparser[h] = compileParser<m_nvars>(m_parser[h].get());
+    }
 
     // get filter parser
     auto fun_filterparser = compileParser<m_nvars>(m_parser_filter.get());
 
-    // declare local variables
-    auto const num_bins = m_bin_num;
-    Real const bin_min  = m_bin_min;
-    Real const bin_size = m_bin_size;
-    const bool is_unity_particle_weight =
-        (m_norm == NormalizationType::unity_particle_weight) ? true : false;
-
-    bool const do_parser_filter = m_do_parser_filter;
+    // copy the parsers and bin parameters of all histograms to the device
+    amrex::Gpu::DeviceVector<amrex::ParserExecutor<m_nvars>> d_fun_partparser(nhist);
+    amrex::Gpu::DeviceVector<int> d_bin_num(nhist), d_bin_offset(nhist);
+    amrex::Gpu::DeviceVector<Real> d_bin_min(nhist), d_bin_size(nhist);
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_fun_partparser.begin(), h_fun_partparser.end(),
+                          d_fun_partparser.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_bin_num.begin(), m_bin_num.end(), d_bin_num.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_bin_offset.begin(), m_bin_offset.end(),
+                          d_bin_offset.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_bin_min.begin(), m_bin_min.end(), d_bin_min.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_bin_size.begin(), m_bin_size.end(), d_bin_size.begin());
+
+    HistogramFiller filler;
+    filler.fun = d_fun_partparser.dataPtr();
+    filler.nhist = nhist;
+    filler.bin_num = d_bin_num.dataPtr();
+    filler.bin_offset = d_bin_offset.dataPtr();
+    filler.bin_min = d_bin_min.dataPtr();
+    filler.bin_size = d_bin_size.dataPtr();
+    filler.filter = fun_filterparser;
+    filler.do_filter = m_do_parser_filter;
+    filler.unity_weight = (m_norm == NormalizationType::unity_particle_weight);
+    filler.t = t;
 
     // zero-out old data on the host
     std::fill(m_data.begin(), m_data.end(), amrex::Real(0.0));
+    int const nbins = static_cast<int>(m_data.size());
+
+#ifdef AMREX_USE_GPU
     amrex::Gpu::DeviceVector< amrex::Real > d_data( m_data.size(), 0.0 );
     amrex::Real* const AMREX_RESTRICT dptr_data = d_data.dataPtr();
 
+#   if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+    // each block accumulates into its own histogram in shared memory, if it fits
+    constexpr int nthreads = 256;
+    std::size_t const shared_mem_bytes = nbins * sizeof(amrex::Real);
+    bool const use_shared_memory = shared_mem_bytes <= amrex::Gpu::Device::sharedMemPerBlock();
+#   endif
+#endif
+
     int const nlevs = std::max(0, myspc.finestLevel()+1);
-    for (int lev = 0; lev < nlevs; ++lev) {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
+    {
+#ifndef AMREX_USE_GPU
+        // each thread accumulates into its own histogram, merged after the loop
+        std::vector<amrex::Real> local_data(nbins, 0.0_rt);
+        amrex::Real* const AMREX_RESTRICT local_ptr = local_data.data();
+#endif
+        for (int lev = 0; lev < nlevs; ++lev)
         {
             for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
             {
-                auto const GetPosition = GetParticlePosition(pti);
+                HistogramFiller pfiller = filler;
+                pfiller.GetPosition = GetParticlePosition(pti);
 
                 auto & attribs = pti.GetAttribs();
-                ParticleReal* const AMREX_RESTRICT d_w = attribs[PIdx::w].dataPtr();
-                ParticleReal* const AMREX_RESTRICT d_ux = attribs[PIdx::ux].dataPtr();
-                ParticleReal* const AMREX_RESTRICT d_uy = attribs[PIdx::uy].dataPtr();
-                ParticleReal* const AMREX_RESTRICT d_uz = attribs[PIdx::uz].dataPtr();
+                pfiller.w  = attribs[PIdx::w].dataPtr();
+                pfiller.ux = attribs[PIdx::ux].dataPtr();
+                pfiller.uy = attribs[PIdx::uy].dataPtr();
+                pfiller.uz = attribs[PIdx::uz].dataPtr();
 
                 long const np = pti.numParticles();
-
-                //Flag particles that need to be copied if they cross the z_slice
-                amrex::ParallelFor(np,
-                   [=] AMREX_GPU_DEVICE(int i)
+                if (np == 0) continue;
+
+#ifndef AMREX_USE_GPU
+                for (long i = 0; i < np; ++i) {
+                    pfiller.operator()<false>(i, local_ptr);
+                }
+#else
+#   if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                if (use_shared_memory)
+                {
+                    int const nblocks = static_cast<int>(std::min<long>(
+                        (np + nthreads - 1) / nthreads, amrex::Gpu::Device::maxBlocksPerLaunch()));
+                    amrex::launch<nthreads>(nblocks, shared_mem_bytes, amrex::Gpu::gpuStream(),
+                    [=] AMREX_GPU_DEVICE () noexcept
+                    {
+                        amrex::Gpu::SharedMemory<amrex::Real> gsm;
+                        amrex::Real* const block_data = gsm.dataPtr();
+                        for (int b = threadIdx.x; b < nbins; b += nthreads) { block_data[b] = 0.0_rt; }
+                        __syncthreads();
+                        for (long i = long(blockIdx.x)*nthreads + threadIdx.x; i < np;
+                             i += long(gridDim.x)*nthreads)
+                        {
+                            pfiller.operator()<true>(i, block_data);
+                        }
+                        __syncthreads();
+                        for (int b = threadIdx.x; b < nbins; b += nthreads) {
+                            if (block_data[b] != 0.0_rt) {
+                                amrex::Gpu::Atomic::AddNoRet(&dptr_data[b], block_data[b]);
+                            }
+                        }
+                    });
+                    continue;
+                }
+#   endif
+                amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long i)
                 {
-                    amrex::ParticleReal x, y, z;
-                    GetPosition(i, x, y, z);
-                    auto const w  = (amrex::Real)d_w[i];
-                    auto const ux = d_ux[i] / PhysConst::c;
-                    auto const uy = d_uy[i] / PhysConst::c;
-                    auto const uz = d_uz[i] / PhysConst::c;
-
-                    // don't count a particle if it is filtered out
-                    if (do_parser_filter)
-                        if (!fun_filterparser(t, x, y, z, ux, uy, uz))
-                            return;
-                    // continue function if particle is not filtered out
-                    auto const f = fun_partparser(t, x, y, z, ux, uy, uz);
-                    // determine particle bin
-                    int const bin = int(Math::floor((f-bin_min)/bin_size));
-                    if ( bin<0 || bin>=num_bins ) return; // discard if out-of-range
-
-                    // add particle to histogram bin
-                    //! @todo performance: on CPU, we are probably faster by
-                    //        letting each thread compute its own histogram and
-                    //        then we reduce the histograms after the loop
-                    if ( is_unity_particle_weight ) {
-                        amrex::HostDevice::Atomic::Add(&dptr_data[bin], 1.0_rt);
-                    } else {
-                        amrex::HostDevice::Atomic::Add(&dptr_data[bin], w);
-                    }
+                    pfiller.operator()<true>(i, dptr_data);
                 });
+#endif
             }
         }
+#ifndef AMREX_USE_GPU
+#ifdef AMREX_USE_OMP
+#pragma omp critical (particle_histogram_merge)
+#endif
+        for (int b = 0; b < nbins; ++b) { m_data[b] += local_data[b]; }
+#endif
     }
 
+#ifdef AMREX_USE_GPU
     // blocking copy from device to host
     amrex::Gpu::copy(amrex::Gpu::deviceToHost,
         d_data.begin(), d_data.end(), m_data.begin());
+#endif
 
     // reduced sum over mpi ranks
     ParallelDescriptor::ReduceRealSum
         (m_data.data(), m_data.size(), ParallelDescriptor::IOProcessorNumber());
 
-    // normalize the maximum value to be one
-    if ( m_norm == NormalizationType::max_to_unity )
+    for (int h = 0; h < nhist; ++h)
     {
-        Real f_max = 0.0_rt;
-        for ( int i = 0; i < m_bin_num; ++i )
-        {
-            if ( m_data[i] > f_max ) f_max = m_data[i];
-        }
-        for ( int i = 0; i < m_bin_num; ++i )
-        {
-            if ( f_max > std::numeric_limits<Real>::min() ) m_data[i] /= f_max;
-        }
-        return;
-    }
+        Real* const hdata = m_data.data() + m_bin_offset[h];
 
-    // normalize the area (integral) to be one
-    if ( m_norm == NormalizationType::area_to_unity )
-    {
-        Real f_area = 0.0_rt;
-        for ( int i = 0; i < m_bin_num; ++i )
+        // normalize the maximum value to be one
+        if ( m_norm == NormalizationType::max_to_unity )
         {
-            f_area += m_data[i] * m_bin_size;
+            Real f_max = 0.0_rt;
+            for ( int i = 0; i < m_bin_num[h]; ++i )
+            {
+                if ( hdata[i] > f_max ) f_max = hdata[i];
+            }
+            for ( int i = 0; i < m_bin_num[h]; ++i )
+            {
+                if ( f_max > std::numeric_limits<Real>::min() ) hdata[i] /= f_max;
+            }
         }
-        for ( int i = 0; i < m_bin_num; ++i )
+
+        // normalize the area (integral) to be one
+        if ( m_norm == NormalizationType::area_to_unity )
         {
-            if ( f_area > std::numeric_limits<Real>::min() ) m_data[i] /= f_area;
+            Real f_area = 0.0_rt;
+            for ( int i = 0; i < m_bin_num[h]; ++i )
+            {
+                f_area += hdata[i] * m_bin_size[h];
+            }
+            for ( int i = 0; i < m_bin_num[h]; ++i )
+            {
+                if ( f_area > std::numeric_limits<Real>::min() ) hdata[i] /= f_area;
+            }
         }
-        return;
     }
 }
 // end void ParticleHistogram::ComputeDiags
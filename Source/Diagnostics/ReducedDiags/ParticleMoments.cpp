@@ -0,0 +1,367 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ParticleMoments.H"
+
+#include "Particles/Algorithms/KineticEnergy.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/SpeciesPhysicalProperties.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Extension.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_ParticleReduce.H>
+#include <AMReX_Particles.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Tuple.H>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    using Q = SpeciesMoments::Quantity;
+    constexpr int nq = SpeciesMoments::nquantities;
+
+    /** Layout of the values reduced for each particle, for a given set of requested
+     *  moments: the sums come first, then the extrema. Minima are reduced as maxima
+     *  of the opposite values, so that all the extrema of all species go through
+     *  a single MPI reduction.
+     */
+    struct MomentsLayout
+    {
+        int i_w;       // w
+        int i_energy;  // w*E_kin
+        int i_first;   // w*(q-shift)
+        int i_second;  // w*(q-shift)^2
+        int i_corr;    // w*(x-shift)*(ux-shift), for x, y, z
+        int nsums;
+        int i_max;     // max(q), then max(w)
+        int i_negmin;  // max(-q), then max(-w)
+        int nextrema;
+    };
+
+    constexpr MomentsLayout GetLayout (int mask)
+    {
+        const bool energy = mask & ParticleMoments::Energy;
+        const bool mean = mask & ParticleMoments::Mean;
+        const bool variance = mask & ParticleMoments::Variance;
+        const bool extrema = mask & ParticleMoments::Extrema;
+        MomentsLayout l{};
+        l.i_w = 0;
+        l.i_energy = l.i_w + 1;
+        l.i_first = l.i_energy + (energy ? 1 : 0);
+        l.i_second = l.i_first + (mean ? nq : 0);
+        l.i_corr = l.i_second + (variance ? nq : 0);
+        l.nsums = l.i_corr + (variance ? 3 : 0);
+        l.i_max = 0;
+        l.i_negmin = l.i_max + (extrema ? nq + 1 : 0);
+        l.nextrema = l.i_negmin + (extrema ? nq + 1 : 0);
+        return l;
+    }
+
+    /** The sum of the weights is always computed, and the second moments need
+     *  the first ones */
+    constexpr int NormalizeMask (int mask)
+    {
+        mask |= ParticleMoments::Weight;
+        if (mask & ParticleMoments::Variance) { mask |= ParticleMoments::Mean; }
+        return mask;
+    }
+
+    constexpr int nmasks = 1 << 5;
+
+    template <typename T, std::size_t>
+    using Repeat = T;
+
+    template <int NSums, std::size_t... I>
+    auto MakeReduceOps (std::index_sequence<I...>) -> ReduceOps<
+        std::conditional_t<(I < std::size_t(NSums)), ReduceOpSum, ReduceOpMax>...>;
+
+    template <std::size_t... I>
+    auto MakeReduceData (std::index_sequence<I...>) -> ReduceData<Repeat<Real, I>...>;
+
+    template <typename Tuple, std::size_t... I>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    Tuple ToTuple (const Real* v, std::index_sequence<I...>) noexcept
+    {
+        return {v[I]...};
+    }
+
+    template <typename Tuple, std::size_t... I>
+    void FromTuple (const Tuple& t, Real* v, std::index_sequence<I...>) noexcept
+    {
+        ((v[I] = amrex::get<I>(t)), ...);
+    }
+
+    /** Reduce, over the particles of one species held by this MPI rank, the values
+     *  needed for the moments in Mask, and append the sums and the extrema to
+     *  the respective vectors
+     */
+    template <int Mask>
+    void ReduceSpecies (const WarpXParticleContainer& myspc,
+                        const std::array<Real, nq>& shift,
+                        std::vector<Real>& sums, std::vector<Real>& extrema)
+    {
+        constexpr MomentsLayout layout = GetLayout(Mask);
+        constexpr int i_w = layout.i_w;
+        constexpr int i_energy = layout.i_energy;
+        constexpr int i_first = layout.i_first;
+        constexpr int i_second = layout.i_second;
+        constexpr int i_corr = layout.i_corr;
+        constexpr int nsums = layout.nsums;
+        constexpr int i_max = layout.i_max;
+        constexpr int i_negmin = layout.i_negmin;
+        constexpr int nvalues = nsums + layout.nextrema;
+        constexpr bool do_energy = Mask & ParticleMoments::Energy;
+        constexpr bool do_mean = Mask & ParticleMoments::Mean;
+        constexpr bool do_variance = Mask & ParticleMoments::Variance;
+        constexpr bool do_extrema = Mask & ParticleMoments::Extrema;
+
+        using Indices = std::make_index_sequence<nvalues>;
+        using MomentsReduceOps = decltype(MakeReduceOps<nsums>(Indices{}));
+        using MomentsReduceData = decltype(MakeReduceData(Indices{}));
+        using MomentsTuple = typename MomentsReduceData::Type;
+
+        // inverse of speed of light squared
+        Real constexpr inv_c2 = 1.0_rt / (PhysConst::c * PhysConst::c);
+
+        // If 2D-XZ, p.pos(1) is z, rather than p.pos(2).
+#if (defined WARPX_DIM_3D)
+        int const index_z = 2;
+#elif (defined WARPX_DIM_XZ || defined WARPX_DIM_RZ)
+        int const index_z = 1;
+#elif (defined WARPX_DIM_1D_Z)
+        int const index_z = 0;
+#endif
+
+        const bool is_photon = myspc.AmIA<PhysicalSpecies::photon>();
+        const Real m = myspc.getMass();
+
+        const Real sx = shift[Q::x], sy = shift[Q::y], sz = shift[Q::z];
+        const Real sux = shift[Q::ux], suy = shift[Q::uy], suz = shift[Q::uz];
+        const Real sg = shift[Q::gamma];
+        amrex::ignore_unused(inv_c2, index_z, is_photon, m, sx, sy, sz, sux, suy, suz, sg);
+
+        using PType = typename WarpXParticleContainer::SuperParticleType;
+
+        // Single pass over the particles of this species held by this MPI rank
+        MomentsReduceOps reduce_ops;
+        auto r = amrex::ParticleReduce<MomentsReduceData>(
+            myspc,
+            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> MomentsTuple
+            {
+                Real v[nvalues];
+                const Real w = p.rdata(PIdx::w);
+                v[i_w] = w;
+
+                if constexpr (do_energy || do_mean || do_extrema) {
+                    const Real ux = p.rdata(PIdx::ux);
+                    const Real uy = p.rdata(PIdx::uy);
+                    const Real uz = p.rdata(PIdx::uz);
+
+                    if constexpr (do_energy) {
+                        v[i_energy] = is_photon ? w*Algorithms::KineticEnergyPhotons(ux,uy,uz)
+                                                : w*Algorithms::KineticEnergy(ux,uy,uz,m);
+                    }
+
+                    if constexpr (do_mean || do_extrema) {
+                        const Real us = ux*ux + uy*uy + uz*uz;
+                        const Real g  = is_photon ? std::sqrt(us*inv_c2) : std::sqrt(1.0_rt + us*inv_c2);
+
+#if (defined WARPX_DIM_1D_Z)
+                        const Real x = 0.0_rt;
+                        const Real y = 0.0_rt;
+#elif (defined WARPX_DIM_RZ)
+                        const Real theta = p.rdata(PIdx::theta);
+                        const Real x = p.pos(0)*std::cos(theta);
+                        const Real y = p.pos(0)*std::sin(theta);
+#elif (defined WARPX_DIM_XZ)
+                        const Real x = p.pos(0);
+                        const Real y = 0.0_rt;
+#else
+                        const Real x = p.pos(0);
+                        const Real y = p.pos(1);
+#endif
+                        const Real z = p.pos(index_z);
+
+                        if constexpr (do_mean) {
+                            const Real d[nq] = {x-sx, y-sy, z-sz, ux-sux, uy-suy, uz-suz, g-sg};
+                            for (int iq = 0; iq < nq; ++iq) {
+                                v[i_first+iq] = w*d[iq];
+                            }
+                            if constexpr (do_variance) {
+                                for (int iq = 0; iq < nq; ++iq) {
+                                    v[i_second+iq] = w*d[iq]*d[iq];
+                                }
+                                for (int idim = 0; idim < 3; ++idim) {
+                                    v[i_corr+idim] = w*d[Q::x+idim]*d[Q::ux+idim];
+                                }
+                            }
+                        }
+
+                        if constexpr (do_extrema) {
+                            const Real q[nq] = {x, y, z, ux, uy, uz, g};
+                            for (int iq = 0; iq < nq; ++iq) {
+                                v[nsums+i_max+iq]    =  q[iq];
+                                v[nsums+i_negmin+iq] = -q[iq];
+                            }
+                            v[nsums+i_max+nq]    =  w;
+                            v[nsums+i_negmin+nq] = -w;
+                        }
+                    }
+                }
+
+                return ToTuple<MomentsTuple>(v, Indices{});
+            },
+            reduce_ops);
+
+        Real v[nvalues];
+        FromTuple(r, v, Indices{});
+
+        sums.insert(sums.end(), v, v+nsums);
+        extrema.insert(extrema.end(), v+nsums, v+nvalues);
+    }
+
+    /** Call ReduceSpecies<M> if M is equal to mask, and return whether it was called */
+    template <int M>
+    bool TryReduceSpecies (int mask, const WarpXParticleContainer& myspc,
+                           const std::array<Real, nq>& shift,
+                           std::vector<Real>& sums, std::vector<Real>& extrema)
+    {
+        // only the normalized masks are instantiated
+        if constexpr (NormalizeMask(M) == M) {
+            if (mask == M) {
+                ReduceSpecies<M>(myspc, shift, sums, extrema);
+                return true;
+            }
+        } else {
+            amrex::ignore_unused(mask, myspc, shift, sums, extrema);
+        }
+        return false;
+    }
+
+    /** Call ReduceSpecies with the compile-time mask equal to mask */
+    template <int... Masks>
+    void ReduceSpeciesDispatch (int mask, std::integer_sequence<int, Masks...>,
+                                const WarpXParticleContainer& myspc,
+                                const std::array<Real, nq>& shift,
+                                std::vector<Real>& sums, std::vector<Real>& extrema)
+    {
+        const bool found = (TryReduceSpecies<Masks>(mask, myspc, shift, sums, extrema) || ...);
+        AMREX_ALWAYS_ASSERT(found);
+    }
+}
+
+void ParticleMoments::Compute (const std::vector<int>& species_flags)
+{
+    WARPX_PROFILE("ParticleMoments::Compute()");
+
+    // get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+
+    // get number of species (int)
+    const int nSpecies = mypc.nSpecies();
+
+    m_moments.resize(nSpecies);
+    m_shift.resize(nSpecies, std::array<Real, nq>{});
+
+    // local values of all flagged species, reduced over MPI ranks together below
+    std::vector<int> species, masks;
+    std::vector<Real> sums, extrema;
+
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        if (species_flags[i_s] == 0) { continue; }
+
+        const int mask = NormalizeMask(species_flags[i_s]);
+
+        // get WarpXParticleContainer class object
+        const auto & myspc = mypc.GetParticleContainer(i_s);
+
+        ReduceSpeciesDispatch(mask, std::make_integer_sequence<int, nmasks>{},
+                              myspc, m_shift[i_s], sums, extrema);
+
+        species.push_back(i_s);
+        masks.push_back(mask);
+    }
+
+    if (species.empty()) { return; }
+
+    // reduce all flagged species over MPI ranks at once
+    ParallelAllReduce::Sum(sums.data(), static_cast<int>(sums.size()),
+                           ParallelDescriptor::Communicator());
+    if (!extrema.empty()) {
+        ParallelAllReduce::Max(extrema.data(), static_cast<int>(extrema.size()),
+                               ParallelDescriptor::Communicator());
+    }
+
+    const Real* s = sums.data();
+    const Real* e = extrema.data();
+    for (int k = 0; k < static_cast<int>(species.size()); ++k)
+    {
+        const int i_s = species[k];
+        const int mask = masks[k];
+        const MomentsLayout layout = GetLayout(mask);
+        auto& mom = m_moments[i_s];
+        auto& shift = m_shift[i_s];
+
+        mom.w_sum = s[layout.i_w];
+        if (mask & Energy) {
+            mom.energy_sum = s[layout.i_energy];
+        }
+
+        // first and second moments about the shift, normalized by the sum of the weights
+        if (mask & Mean) {
+            const Real inv_w = (mom.w_sum > std::numeric_limits<Real>::min()) ? 1.0_rt/mom.w_sum : 0.0_rt;
+            std::array<Real, nq> d1;
+            for (int iq = 0; iq < nq; ++iq) {
+                d1[iq] = s[layout.i_first+iq]*inv_w;
+                mom.mean[iq] = shift[iq] + d1[iq];
+                mom.sum[iq] = s[layout.i_first+iq] + shift[iq]*mom.w_sum;
+            }
+            if (mask & Variance) {
+                for (int iq = 0; iq < nq; ++iq) {
+                    mom.variance[iq] = std::max(s[layout.i_second+iq]*inv_w - d1[iq]*d1[iq], 0.0_rt);
+                }
+                for (int idim = 0; idim < 3; ++idim) {
+                    mom.correlation[idim] = s[layout.i_corr+idim]*inv_w - d1[Q::x+idim]*d1[Q::ux+idim];
+                }
+            }
+
+            // the means of this call are the shift of the next one
+            if (mom.w_sum > std::numeric_limits<Real>::min()) { shift = mom.mean; }
+        }
+
+        if (mask & Extrema) {
+            for (int iq = 0; iq < nq; ++iq) {
+                mom.max[iq] =  e[layout.i_max+iq];
+                mom.min[iq] = -e[layout.i_negmin+iq];
+            }
+            mom.w_max =  e[layout.i_max+nq];
+            mom.w_min = -e[layout.i_negmin+nq];
+        }
+
+        s += layout.nsums;
+        e += layout.nextrema;
+    }
+}
@@ -7,17 +7,14 @@
 
 #include "ParticleNumber.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/IntervalsParser.H"
 #include "WarpX.H"
 
-#include <AMReX_GpuQualifiers.H>
-#include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
-#include <AMReX_ParticleReduce.H>
-#include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
 
 #include <algorithm>
@@ -84,6 +81,13 @@ ParticleNumber::ParticleNumber (std::string rd_name)
 }
 // end constructor
 
+void ParticleNumber::RequestParticleMoments (int step, std::vector<int>& species_flags) const
+{
+    if (!m_intervals.contains(step+1)) { return; }
+
+    for (auto& flags : species_flags) { flags |= ParticleMoments::Weight; }
+}
+
 // function that computes total number of macroparticles and physical particles
 void ParticleNumber::ComputeDiags (int step)
 {
@@ -118,18 +122,8 @@ void ParticleNumber::ComputeDiags (int step)
         // Save total number of macroparticles for this species
         m_data[idx_first_species_macroparticles + i_s] = myspc.TotalNumberOfParticles();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        // Reduction to compute sum of weights for this species
-        auto Wtot = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> amrex::Real
-        {
-            return p.rdata(PIdx::w);
-        });
-
-        // MPI reduction
-        amrex::ParallelDescriptor::ReduceRealSum
-            (Wtot, amrex::ParallelDescriptor::IOProcessorNumber());
+        // Sum of weights for this species
+        const auto Wtot = (*m_particle_moments)[i_s].w_sum;
 
         // Save sum of particles weight for this species
         m_data[idx_first_species_sum_weight + i_s] = Wtot;
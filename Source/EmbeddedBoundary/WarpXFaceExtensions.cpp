@@ -11,10 +11,17 @@
 
 #include <ablastr/warn_manager/WarnManager.H>
 
+#include <AMReX_BoxList.H>
+#include <AMReX_FabArray.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_Scan.H>
 #include <AMReX_iMultiFab.H>
 #include <AMReX_MultiFab.H>
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
 /**
 * \brief Get the value of arr in the neighbor (i_n, j_n) on the plane with normal 'dim'.
 *
@@ -256,46 +263,24 @@ WarpX::ComputeFaceExtensions(){
 
 void
 WarpX::InitBorrowing() {
-    int idim = 0;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_x = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_x.inds_pointer.resize(box);
-        borrowing_x.size.resize(box);
-        borrowing_x.size.setVal<amrex::RunOn::Device>(0);
-        amrex::Long ncells = box.numPts();
-        // inds, neigh_faces and area are extended to their largest possible size here, but they are
-        // resized to a much smaller size later on, based on the actual number of neighboring
-        // intruded faces for each unstable face.
-        borrowing_x.inds.resize(8*ncells);
-        borrowing_x.neigh_faces.resize(8*ncells);
-        borrowing_x.area.resize(8*ncells);
-    }
-
-    idim = 1;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_y = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_y.inds_pointer.resize(box);
-        borrowing_y.size.resize(box);
-        borrowing_y.size.setVal<amrex::RunOn::Device>(0);
-        amrex::Long ncells = box.numPts();
-        borrowing_y.inds.resize(8*ncells);
-        borrowing_y.neigh_faces.resize(8*ncells);
-        borrowing_y.area.resize(8*ncells);
-    }
-
-    idim = 2;
-    for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
-        amrex::Box const &box = mfi.validbox();
-        auto &borrowing_z = (*m_borrowing[maxLevel()][idim])[mfi];
-        borrowing_z.inds_pointer.resize(box);
-        borrowing_z.size.resize(box);
-        borrowing_z.size.setVal<amrex::RunOn::Device>(0);
-        amrex::Long ncells = box.numPts();
-        borrowing_z.inds.resize(8*ncells);
-        borrowing_z.neigh_faces.resize(8*ncells);
-        borrowing_z.area.resize(8*ncells);
+    for (int idim = 0; idim < 3; ++idim) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
+            amrex::Box const &box = mfi.validbox();
+            auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
+            borrowing.inds_pointer.resize(box);
+            borrowing.inds_pointer.setVal<amrex::RunOn::Device>(nullptr);
+            borrowing.size.resize(box);
+            borrowing.size.setVal<amrex::RunOn::Device>(0);
+            borrowing.vecs_size = 0;
+            // inds, neigh_faces and area are grown by the one-way and eight-ways extensions,
+            // by the number of entries that each of them reserves
+            borrowing.inds.clear();
+            borrowing.neigh_faces.clear();
+            borrowing.area.clear();
+        }
     }
 }
 
@@ -422,21 +407,22 @@ WarpX::ComputeOneWayExtensions() {
 #else
         amrex::Abort(Utils::TextMsg::Err(
             "ComputeOneWayExtensions: Only implemented in 2D3V and 3D3V"));
+#endif
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
 
             amrex::Box const &box = mfi.validbox();
 
+            auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
+
             auto const &S = m_face_areas[maxLevel()][idim]->array(mfi);
             auto const &flag_ext_face = m_flag_ext_face[maxLevel()][idim]->array(mfi);
             auto const &flag_info_face = m_flag_info_face[maxLevel()][idim]->array(mfi);
-            auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
             auto const &borrowing_inds_pointer = borrowing.inds_pointer.array();
             auto const &borrowing_size = borrowing.size.array();
             amrex::Long ncells = box.numPts();
-            int* borrowing_inds = borrowing.inds.data();
-            FaceInfoBox::Neighbours* borrowing_neigh_faces = borrowing.neigh_faces.data();
-            amrex::Real* borrowing_area = borrowing.area.data();
             int& vecs_size = borrowing.vecs_size;
 
             auto const &S_mod = m_area_mod[maxLevel()][idim]->array(mfi);
@@ -445,38 +431,64 @@ WarpX::ComputeOneWayExtensions() {
             const auto &ly = m_edge_lengths[maxLevel()][1]->array(mfi);
             const auto &lz = m_edge_lengths[maxLevel()][2]->array(mfi);
 
-            vecs_size = amrex::Scan::PrefixSum<int>(ncells,
-                                                    [=] AMREX_GPU_DEVICE (int icell) {
-                const amrex::Dim3 cell = box.atOffset(icell).dim3();
-                const int i = cell.x;
-                const int j = cell.y;
-                const int k = cell.z;
-                // If the face doesn't need to be extended break the loop
-                if (!flag_ext_face(i, j, k)) {
-                    return 0;
-                }
+            // Count the neighboring faces that each face to be extended can borrow area
+            // from, and reserve exactly this number of entries in the borrowing vectors.
+            // The faces intruded below are a subset of the ones counted here, since the
+            // intruded faces only lose area.
+            amrex::ReduceOps<amrex::ReduceOpSum> reduce_ops;
+            amrex::ReduceData<int> reduce_data(reduce_ops);
+            reduce_ops.eval(box, reduce_data,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) -> amrex::GpuTuple<int> {
+                    // If the face doesn't need to be extended break the loop
+                    if (!flag_ext_face(i, j, k)) {
+                        return 0;
+                    }
 
-                const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
+                    const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
 
-                const amrex::Real S_ext = S_stab - S(i, j, k);
-                const int n_borrow =
-                    ComputeNBorrowOneFaceExtension(cell, S_ext, S_mod, flag_info_face,
-                                                   flag_ext_face, idim);
+                    const amrex::Real S_ext = S_stab - S(i, j, k);
+                    const int n_borrow =
+                        ComputeNBorrowOneFaceExtension(amrex::Dim3{i, j, k}, S_ext, S_mod,
+                                                       flag_info_face, flag_ext_face, idim);
 
+                    borrowing_size(i, j, k) = n_borrow;
+                    return n_borrow;
+                });
+            const int n_borrow_box = amrex::get<0>(reduce_data.value(reduce_ops));
+            // Nothing to do in the boxes without faces to be extended
+            if (n_borrow_box == 0) continue;
 
-              borrowing_size(i, j, k) = n_borrow;
-                return n_borrow;
+            borrowing.inds.resize(vecs_size + n_borrow_box);
+            borrowing.neigh_faces.resize(vecs_size + n_borrow_box);
+            borrowing.area.resize(vecs_size + n_borrow_box);
+            int* borrowing_inds = borrowing.inds.data();
+            FaceInfoBox::Neighbours* borrowing_neigh_faces = borrowing.neigh_faces.data();
+            amrex::Real* borrowing_area = borrowing.area.data();
+
+            vecs_size += amrex::Scan::PrefixSum<int>(ncells,
+                                                     [=] AMREX_GPU_DEVICE (int icell) {
+                const amrex::Dim3 cell = box.atOffset(icell).dim3();
+                return flag_ext_face(cell.x, cell.y, cell.z) ? borrowing_size(cell.x, cell.y, cell.z) : 0;
             },
                                                 [=] AMREX_GPU_DEVICE (int icell, int ps){
+
+                ps += vecs_size;
+
                 const amrex::Dim3 cell = box.atOffset(icell).dim3();
                 const int i = cell.x;
                 const int j = cell.y;
                 const int k = cell.z;
+
+                if (!flag_ext_face(i, j, k)) {
+                    return;
+                }
+
                 const int nborrow = borrowing_size(i, j, k);
                 if (nborrow == 0) {
                     borrowing_inds_pointer(i, j, k) = nullptr;
                 } else{
                     borrowing_inds_pointer(i, j, k) = borrowing_inds + ps;
+                    int count = 0;
 
                     const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
 
@@ -499,22 +511,28 @@ WarpX::ComputeOneWayExtensions() {
                                              GetNeigh(S_mod, i, j, k, i_n, j_n, idim) - S_ext,
                                              i, j, k, i_n, j_n, idim);
 
+                                    AMREX_ASSERT(count < nborrow);
                                     // Insert the index of the face info
-                                    borrowing_inds[ps] = ps;
+                                    borrowing_inds[ps + count] = ps + count;
                                     // Store the information about the intruded face in the dataset of the
                                     // faces which are borrowing area
-                                    FaceInfoBox::addConnectedNeighbor(i_n, j_n, ps,
+                                    FaceInfoBox::addConnectedNeighbor(i_n, j_n, ps + count,
                                                                       borrowing_neigh_faces);
-                                    borrowing_area[ps] = S_ext;
+                                    borrowing_area[ps + count] = S_ext;
 
                                     SetNeigh(flag_info_face, 2, i, j, k, i_n, j_n, idim);
                                     // Add the area to the intruding face.
                                     S_mod(i, j, k) = S(i, j, k) + S_ext;
                                     flag_ext_face(i, j, k) = false;
+                                    count += 1;
                                 }
                             }
                         }
                     }
+                    // The entries reserved for a face which could not be extended (because
+                    // its neighbors were intruded in the meantime) are left unused
+                    borrowing_size(i, j, k) = count;
+                    if (count == 0) borrowing_inds_pointer(i, j, k) = nullptr;
                 }
             }, amrex::Scan::Type::exclusive);
         }
@@ -544,21 +562,22 @@ WarpX::ComputeEightWaysExtensions() {
 #else
         amrex::Abort(Utils::TextMsg::Err(
             "ComputeEightWaysExtensions: Only implemented in 2D3V and 3D3V"));
+#endif
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
         for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
 
             amrex::Box const &box = mfi.validbox();
 
+            auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
+
             auto const &S = m_face_areas[maxLevel()][idim]->array(mfi);
             auto const &flag_ext_face = m_flag_ext_face[maxLevel()][idim]->array(mfi);
             auto const &flag_info_face = m_flag_info_face[maxLevel()][idim]->array(mfi);
-            auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
             auto const &borrowing_inds_pointer = borrowing.inds_pointer.array();
             auto const &borrowing_size = borrowing.size.array();
             amrex::Long ncells = box.numPts();
-            int* borrowing_inds = borrowing.inds.data();
-            FaceInfoBox::Neighbours* borrowing_neigh_faces = borrowing.neigh_faces.data();
-            amrex::Real* borrowing_area = borrowing.area.data();
             int& vecs_size = borrowing.vecs_size;
 
             auto const &S_mod = m_area_mod[maxLevel()][idim]->array(mfi);
@@ -566,24 +585,43 @@ WarpX::ComputeEightWaysExtensions() {
             const auto &ly = m_edge_lengths[maxLevel()][1]->array(mfi);
             const auto &lz = m_edge_lengths[maxLevel()][2]->array(mfi);
 
+            // Count the neighboring faces that each face still to be extended can borrow
+            // area from, and reserve exactly this number of entries after the ones of the
+            // one-way extensions. As above, the faces intruded below are a subset of the
+            // ones counted here.
+            amrex::ReduceOps<amrex::ReduceOpSum> reduce_ops;
+            amrex::ReduceData<int> reduce_data(reduce_ops);
+            reduce_ops.eval(box, reduce_data,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) -> amrex::GpuTuple<int> {
+                    // If the face doesn't need to be extended break the loop
+                    if (!flag_ext_face(i, j, k)) {
+                        return 0;
+                    }
+                    const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
+
+                    const amrex::Real S_ext = S_stab - S(i, j, k);
+                    const int n_borrow = ComputeNBorrowEightFacesExtension(amrex::Dim3{i, j, k},
+                                                                           S_ext, S_mod, S,
+                                                                           flag_info_face, idim);
+
+                    borrowing_size(i, j, k) = n_borrow;
+                    return n_borrow;
+                });
+            const int n_borrow_box = amrex::get<0>(reduce_data.value(reduce_ops));
+            // Nothing to do in the boxes without faces to be extended
+            if (n_borrow_box == 0) continue;
+
+            borrowing.inds.resize(vecs_size + n_borrow_box);
+            borrowing.neigh_faces.resize(vecs_size + n_borrow_box);
+            borrowing.area.resize(vecs_size + n_borrow_box);
+            int* borrowing_inds = borrowing.inds.data();
+            FaceInfoBox::Neighbours* borrowing_neigh_faces = borrowing.neigh_faces.data();
+            amrex::Real* borrowing_area = borrowing.area.data();
+
             vecs_size += amrex::Scan::PrefixSum<int>(ncells,
                                                      [=] AMREX_GPU_DEVICE (int icell){
                 const amrex::Dim3 cell = box.atOffset(icell).dim3();
-                const int i = cell.x;
-                const int j = cell.y;
-                const int k = cell.z;
-                // If the face doesn't need to be extended break the loop
-                if (!flag_ext_face(i, j, k)) {
-                    return 0;
-                }
-                const amrex::Real S_stab = ComputeSStab(i, j, k, lx, ly, lz, dx, dy, dz, idim);
-
-                const amrex::Real S_ext = S_stab - S(i, j, k);
-                const int n_borrow = ComputeNBorrowEightFacesExtension(cell, S_ext, S_mod, S,
-                                                                       flag_info_face, idim);
-
-              borrowing_size(i, j, k) = n_borrow;
-                return n_borrow;
+                return flag_ext_face(cell.x, cell.y, cell.z) ? borrowing_size(cell.x, cell.y, cell.z) : 0;
             },
             [=] AMREX_GPU_DEVICE (int icell, int ps) {
 
@@ -651,13 +689,14 @@ WarpX::ComputeEightWaysExtensions() {
                                 local_avail(2, 2) * GetNeigh(S, i, j, k, 1, 1, idim);
                     }
 
+                    int count = 0;
                     if(denom >= S_ext){
                         S_mod(i, j, k) = S(i, j, k);
-                        int count = 0;
                         for (int i_n = -1; i_n < 2; i_n++) {
                             for (int j_n = -1; j_n < 2; j_n++) {
                                 if(local_avail(i_n + 1, j_n + 1)){
                                     const amrex::Real patch = S_ext * GetNeigh(S, i, j, k, i_n, j_n, idim) / denom;
+                                    AMREX_ASSERT(count < nborrow);
                                     borrowing_inds[ps + count] = ps + count;
                                     FaceInfoBox::addConnectedNeighbor(i_n, j_n, ps + count,
                                                                       borrowing_neigh_faces);
@@ -675,6 +714,10 @@ WarpX::ComputeEightWaysExtensions() {
                         }
                         flag_ext_face(i, j, k) = false;
                     }
+                    // The entries reserved for a face which could not be extended are left
+                    // unused (this face is then stabilized with the BCK correction)
+                    borrowing_size(i, j, k) = count;
+                    if (count == 0) borrowing_inds_pointer(i, j, k) = nullptr;
                 }
             }, amrex::Scan::Type::exclusive);
         }
@@ -719,6 +762,9 @@ WarpX::ApplyBCKCorrection(const int idim) {
 void
 WarpX::ShrinkBorrowing() {
     for(int idim = 0; idim < AMREX_SPACEDIM; idim++) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
         for (amrex::MFIter mfi(*Bfield_fp[maxLevel()][idim]); mfi.isValid(); ++mfi) {
             auto &borrowing = (*m_borrowing[maxLevel()][idim])[mfi];
             borrowing.inds.resize(borrowing.vecs_size);
@@ -727,3 +773,133 @@ WarpX::ShrinkBorrowing() {
         }
     }
 }
+
+void
+WarpX::RedistributeBorrowing (const int lev, const int idim, const amrex::DistributionMapping& dm)
+{
+    amrex::LayoutData<FaceInfoBox>& borrowing = *m_borrowing[lev][idim];
+    const amrex::BoxArray& ba = borrowing.boxArray();
+    const amrex::DistributionMapping old_dm = borrowing.DistributionMap();
+    auto new_borrowing = std::make_unique<amrex::LayoutData<FaceInfoBox>>(ba, dm);
+
+    // Boxes that change owner
+    amrex::Vector<int> moved, moved_index(ba.size(), -1);
+    amrex::Vector<int> old_pmap, new_pmap;
+    amrex::BoxList moved_bl(ba.ixType());
+    for (int i = 0; i < ba.size(); ++i) {
+        if (old_dm[i] == dm[i]) continue;
+        moved_index[i] = static_cast<int>(moved.size());
+        moved.push_back(i);
+        old_pmap.push_back(old_dm[i]);
+        new_pmap.push_back(dm[i]);
+        moved_bl.push_back(ba[i]);
+    }
+    const int n_moved = static_cast<int>(moved.size());
+
+    if (n_moved > 0) {
+        const amrex::DistributionMapping moved_old_dm(std::move(old_pmap));
+        const amrex::DistributionMapping moved_new_dm(std::move(new_pmap));
+
+        // Number of entries of the borrowing vectors of each box, known by all ranks
+        amrex::Vector<amrex::Long> n_vecs(n_moved, 0);
+        for (amrex::MFIter mfi(ba, old_dm); mfi.isValid(); ++mfi) {
+            const int im = moved_index[mfi.index()];
+            if (im >= 0) n_vecs[im] = borrowing[mfi].vecs_size;
+        }
+        amrex::ParallelDescriptor::ReduceLongSum(n_vecs.data(), n_moved);
+
+        // The vectors of the boxes are laid out one after the other along x
+        // (with at least one entry per box), and sent with the same one-to-one
+        // copy as the per-face data
+        amrex::BoxList vecs_bl;
+        amrex::Vector<int> vecs_start(n_moved);
+        int offset = 0;
+        for (int im = 0; im < n_moved; ++im) {
+            const int n = std::max(static_cast<int>(n_vecs[im]), 1);
+            amrex::Box bx(amrex::IntVect(0), amrex::IntVect(0));
+            bx.setSmall(0, offset);
+            bx.setBig(0, offset + n - 1);
+            vecs_bl.push_back(bx);
+            vecs_start[im] = offset;
+            offset += n;
+        }
+        const amrex::BoxArray moved_ba(std::move(moved_bl));
+        const amrex::BoxArray vecs_ba(std::move(vecs_bl));
+
+        // Per face: number of entries and offset of the first one (-1 if none).
+        // Per entry: index and neighbor (as int) and area.
+        amrex::FabArray<amrex::BaseFab<int>> faces_old(moved_ba, moved_old_dm, 2, 0);
+        amrex::FabArray<amrex::BaseFab<int>> inds_old(vecs_ba, moved_old_dm, 2, 0);
+        amrex::FabArray<amrex::BaseFab<amrex::Real>> area_old(vecs_ba, moved_old_dm, 1, 0);
+        for (amrex::MFIter mfi(faces_old); mfi.isValid(); ++mfi) {
+            const int im = mfi.index();
+            FaceInfoBox& b = borrowing[moved[im]];
+            auto const& size = b.size.const_array();
+            auto const& inds_pointer = b.inds_pointer.const_array();
+            auto const& faces = faces_old.array(mfi);
+            const int* inds = b.inds.data();
+            const FaceInfoBox::Neighbours* neigh_faces = b.neigh_faces.data();
+            const amrex::Real* area = b.area.data();
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                faces(i, j, k, 0) = size(i, j, k);
+                faces(i, j, k, 1) = inds_pointer(i, j, k) ? static_cast<int>(inds_pointer(i, j, k) - inds) : -1;
+            });
+            auto const& v = inds_old.array(mfi);
+            auto const& a = area_old.array(mfi);
+            const int x0 = vecs_start[im];
+            amrex::ParallelFor(b.vecs_size, [=] AMREX_GPU_DEVICE (int m) {
+                v(x0 + m, 0, 0, 0) = inds[m];
+                v(x0 + m, 0, 0, 1) = static_cast<int>(neigh_faces[m]);
+                a(x0 + m, 0, 0) = area[m];
+            });
+        }
+
+        amrex::FabArray<amrex::BaseFab<int>> faces_new(moved_ba, moved_new_dm, 2, 0);
+        amrex::FabArray<amrex::BaseFab<int>> inds_new(vecs_ba, moved_new_dm, 2, 0);
+        amrex::FabArray<amrex::BaseFab<amrex::Real>> area_new(vecs_ba, moved_new_dm, 1, 0);
+        faces_new.Redistribute(faces_old, 0, 0, 2, amrex::IntVect(0));
+        inds_new.Redistribute(inds_old, 0, 0, 2, amrex::IntVect(0));
+        area_new.Redistribute(area_old, 0, 0, 1, amrex::IntVect(0));
+
+        for (amrex::MFIter mfi(faces_new); mfi.isValid(); ++mfi) {
+            const int im = mfi.index();
+            FaceInfoBox& b = (*new_borrowing)[moved[im]];
+            const amrex::Box& box = mfi.validbox();
+            const int n = static_cast<int>(n_vecs[im]);
+            b.vecs_size = n;
+            b.size.resize(box);
+            b.inds_pointer.resize(box);
+            b.inds.resize(n);
+            b.neigh_faces.resize(n);
+            b.area.resize(n);
+            auto const& size = b.size.array();
+            auto const& inds_pointer = b.inds_pointer.array();
+            auto const& faces = faces_new.const_array(mfi);
+            int* inds = b.inds.data();
+            FaceInfoBox::Neighbours* neigh_faces = b.neigh_faces.data();
+            amrex::Real* area = b.area.data();
+            amrex::ParallelFor(box, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                size(i, j, k) = faces(i, j, k, 0);
+                inds_pointer(i, j, k) = faces(i, j, k, 1) >= 0 ? inds + faces(i, j, k, 1) : nullptr;
+            });
+            auto const& v = inds_new.const_array(mfi);
+            auto const& a = area_new.const_array(mfi);
+            const int x0 = vecs_start[im];
+            amrex::ParallelFor(n, [=] AMREX_GPU_DEVICE (int m) {
+                inds[m] = v(x0 + m, 0, 0, 0);
+                neigh_faces[m] = static_cast<FaceInfoBox::Neighbours>(v(x0 + m, 0, 0, 1));
+                area[m] = a(x0 + m, 0, 0);
+            });
+        }
+        amrex::Gpu::streamSynchronize();
+    }
+
+    // The boxes that keep their owner keep their face extensions
+    for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi) {
+        if (moved_index[mfi.index()] < 0) {
+            (*new_borrowing)[mfi] = std::move(borrowing[mfi.index()]);
+        }
+    }
+
+    m_borrowing[lev][idim] = std::move(new_borrowing);
+}
@@ -22,6 +22,7 @@
 #       include "FieldSolver/SpectralSolver/SpectralSolver.H"
 #   endif
 #endif
+#include "Filter/NCIGodfreyFilter.H"
 #include "Parallelization/GuardCellManager.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
@@ -93,6 +94,11 @@ WarpX::Evolve (int numsteps)
         }
         ExecutePythonCallback("beforestep");
 
+        // Create, resize or remove the refinement patches
+        if (step > 0 && max_level > 0 && regrid_int > 0 && step % regrid_int == 0) {
+            RegridLevels(cur_time);
+        }
+
         amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(0);
         if (cost) {
             if (step > 0 && load_balance_intervals.contains(step+1))
@@ -111,9 +117,17 @@ WarpX::Evolve (int numsteps)
                     // (Giving more importance to most recent costs; only needed
                     // for timers update, heuristic load balance considers the
                     // instantaneous costs)
+                    const amrex::Real decay = 1._rt - 2._rt/load_balance_intervals.localPeriod(step+1);
                     for (int i : cost->IndexArray())
                     {
-                        (*cost)[i] *= (1._rt - 2._rt/load_balance_intervals.localPeriod(step+1));
+                        (*cost)[i] *= decay;
+                    }
+                    if (cost_phases[lev])
+                    {
+                        for (int i : cost_phases[lev]->IndexArray())
+                        {
+                            for (auto& c : (*cost_phases[lev])[i]) c *= decay;
+                        }
                     }
                 }
             }
@@ -371,6 +385,7 @@ WarpX::Evolve (int numsteps)
         // End loop on time steps
     }
     multi_diags->FilterComputePackFlushLastTimestep( istep[0] );
+    if (reduced_diags->m_plot_rd != 0) { reduced_diags->Flush(); }
 
     if (do_back_transformed_diagnostics) {
         myBFD->Flush(geom[0]);
@@ -451,6 +466,11 @@ WarpX::OneStep_nosub (Real cur_time)
         if (do_pml) {
             NodalSyncPML();
         }
+    } else if (WarpX::fused_fdtd_update) {
+        // B^{n+1/2}, E^{n+1} and B^{n+1} in a single sweep over the grids: the guard
+        // cells of E and B needed for the three half steps were exchanged at the
+        // beginning of the step, and those of J in SyncCurrent
+        EvolveEBFused(dt[0]);
     } else {
         EvolveF(0.5_rt * dt[0], DtType::FirstHalf);
         EvolveG(0.5_rt * dt[0], DtType::FirstHalf);
@@ -884,14 +904,33 @@ WarpX::PushParticlesandDepose (int lev, amrex::Real cur_time, DtType a_dt_type,
         current_z = current_fp[lev][2].get();
     }
 
+    // Fields gathered by the particles
+    std::array<const amrex::MultiFab*,3> E_gather = {
+        Efield_aux[lev][0].get(), Efield_aux[lev][1].get(), Efield_aux[lev][2].get() };
+    std::array<const amrex::MultiFab*,3> B_gather = {
+        Bfield_aux[lev][0].get(), Bfield_aux[lev][1].get(), Bfield_aux[lev][2].get() };
+    std::array<const amrex::MultiFab*,3> cE_gather = {
+        Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get() };
+    std::array<const amrex::MultiFab*,3> cB_gather = {
+        Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get() };
+
+    if (WarpX::use_fdtd_nci_corr)
+    {
+        // Filter the fields once here, rather than once per species in the particle push
+        ApplyNCIFilterToGatherFields(lev, lev, E_gather, B_gather, 0);
+        if (cE_gather[0]) {
+            ApplyNCIFilterToGatherFields(lev, lev-1, cE_gather, cB_gather, 3);
+        }
+    }
+
     mypc->Evolve(lev,
-                 *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
-                 *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2],
+                 *E_gather[0], *E_gather[1], *E_gather[2],
+                 *B_gather[0], *B_gather[1], *B_gather[2],
                  *current_x, *current_y, *current_z,
                  current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
                  rho_fp[lev].get(), charge_buf[lev].get(),
-                 Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
-                 Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
+                 cE_gather[0], cE_gather[1], cE_gather[2],
+                 cB_gather[0], cB_gather[1], cB_gather[2],
                  cur_time, dt[lev], a_dt_type, skip_deposition);
 #ifdef WARPX_DIM_RZ
     if (! skip_deposition) {
@@ -910,6 +949,45 @@ WarpX::PushParticlesandDepose (int lev, amrex::Real cur_time, DtType a_dt_type,
 #endif
 }
 
+void
+WarpX::ApplyNCIFilterToGatherFields (int lev, int filter_lev,
+                                     std::array<const amrex::MultiFab*,3>& E,
+                                     std::array<const amrex::MultiFab*,3>& B, int slot)
+{
+    WARPX_PROFILE("WarpX::ApplyNCIFilterToGatherFields()");
+
+    // Same filter for fields Ex, Ey and Bz, and for fields Bx, By and Ez
+    NCIGodfreyFilter& filter_exeybz = *nci_godfrey_filter_exeybz[filter_lev];
+    NCIGodfreyFilter& filter_bxbyez = *nci_godfrey_filter_bxbyez[filter_lev];
+
+    // The filtered fields are needed on the tiles grown by the particle shape
+#if defined(WARPX_DIM_1D_Z)
+    const amrex::IntVect ng(static_cast<int>(WarpX::noz));
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    const amrex::IntVect ng(static_cast<int>(WarpX::nox), static_cast<int>(WarpX::noz));
+#else
+    const amrex::IntVect ng(static_cast<int>(WarpX::nox), static_cast<int>(WarpX::noy),
+                            static_cast<int>(WarpX::noz));
+#endif
+
+    const auto filter_field = [lev, &ng] (NCIGodfreyFilter& filter, const amrex::MultiFab*& field,
+                                          int field_slot)
+    {
+        amrex::MultiFab& filtered = filter.GetScratch(*field, field->nComp(), ng, field_slot);
+        filter.ApplyStencil(filtered, *field, lev);
+        field = &filtered;
+    };
+
+    filter_field(filter_exeybz, E[0], slot);
+    filter_field(filter_bxbyez, E[2], slot+2);
+    filter_field(filter_bxbyez, B[1], slot+1);
+#if defined(WARPX_DIM_3D)
+    filter_field(filter_exeybz, E[1], slot+1);
+    filter_field(filter_bxbyez, B[0], slot);
+    filter_field(filter_exeybz, B[2], slot+2);
+#endif
+}
+
 /* \brief Apply perfect mirror condition inside the box (not at a boundary).
  * In practice, set all fields to 0 on a section of the simulation domain
  * (as for a perfect conductor with a given thickness).
@@ -983,5 +1061,6 @@ WarpX::HandleSignals()
 
     if (SignalHandling::TestAndResetActionRequestFlag(SignalHandling::SIGNAL_REQUESTS_CHECKPOINT)) {
         multi_diags->FilterComputePackFlushLastTimestep( istep[0] );
+        if (reduced_diags->m_plot_rd != 0) { reduced_diags->Flush(); }
     }
 }
@@ -17,6 +17,7 @@
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
 #include <AMReX.H>
@@ -118,7 +119,7 @@ void FiniteDifferenceSolver::EvolveBCartesian (
         {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         // Extract field data for this grid/tile
         Array4<Real> const& Bx = Bfield[0]->array(mfi);
@@ -136,6 +137,13 @@ void FiniteDifferenceSolver::EvolveBCartesian (
         Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
         int const n_coefs_z = m_stencil_coefs_z.size();
 
+        // If G is not a null pointer, B is further updated using the grad(G) term
+        // (div(B) cleaning correction for errors in magnetic Gauss law), in the
+        // same pass over the cells as the curl(E) term
+        bool const has_G = static_cast<bool>(Gfield);
+        Array4<Real> G;
+        if (has_G) G = Gfield->array(mfi);
+
         // Extract tileboxes for which to loop
         Box const& tbx  = mfi.tilebox(Bfield[0]->ixType().toIntVect());
         Box const& tby  = mfi.tilebox(Bfield[1]->ixType().toIntVect());
@@ -148,6 +156,7 @@ void FiniteDifferenceSolver::EvolveBCartesian (
 
                 Bx(i, j, k) += dt * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
                              - dt * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
+                if (has_G) Bx(i, j, k) += dt * T_Algo::DownwardDx(G, coefs_x, n_coefs_x, i, j, k);
 
             },
 
@@ -155,6 +164,7 @@ void FiniteDifferenceSolver::EvolveBCartesian (
 
                 By(i, j, k) += dt * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
                              - dt * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
+                if (has_G) By(i, j, k) += dt * T_Algo::DownwardDy(G, coefs_y, n_coefs_y, i, j, k);
 
             },
 
@@ -162,39 +172,16 @@ void FiniteDifferenceSolver::EvolveBCartesian (
 
                 Bz(i, j, k) += dt * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
                              - dt * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
+                if (has_G) Bz(i, j, k) += dt * T_Algo::DownwardDz(G, coefs_z, n_coefs_z, i, j, k);
 
             }
         );
 
-        // div(B) cleaning correction for errors in magnetic Gauss law (div(B) = 0)
-        if (Gfield)
-        {
-            // Extract field data for this grid/tile
-            Array4<Real> G = Gfield->array(mfi);
-
-            // Loop over cells and update G
-            amrex::ParallelFor(tbx, tby, tbz,
-
-                [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                {
-                    Bx(i,j,k) += dt * T_Algo::DownwardDx(G, coefs_x, n_coefs_x, i, j, k);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                {
-                    By(i,j,k) += dt * T_Algo::DownwardDy(G, coefs_y, n_coefs_y, i, j, k);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                {
-                    Bz(i,j,k) += dt * T_Algo::DownwardDz(G, coefs_z, n_coefs_z, i, j, k);
-                }
-            );
-        }
-
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
@@ -227,11 +214,16 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for (MFIter mfi(*Bfield[0]); mfi.isValid(); ++mfi) {
+        // Skip the grids where all the faces are covered by embedded boundaries
+        // and only check the face areas cell by cell in the cut grids
+        int const eb_tile_type = GetEBFaceTileType(mfi);
+        if (eb_tile_type == EBTileType::Covered) continue;
+        bool const eb_cut = (eb_tile_type != EBTileType::Regular);
 
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers) {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
             // Extract field data for this grid/tile
@@ -257,7 +249,7 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
             //Take care of the unstable cells
             amrex::ParallelFor(tb, [=] AMREX_GPU_DEVICE(int i, int j, int k) {
 
-                if (S(i, j, k) <= 0) return;
+                if (eb_cut && S(i, j, k) <= 0) return;
 
                 if (!(flag_info_cell_dim(i, j, k) == 0))
                     return;
@@ -334,7 +326,7 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
 
             //Take care of the stable cells
             amrex::ParallelFor(tb, [=] AMREX_GPU_DEVICE(int i, int j, int k) {
-                if (S(i, j, k) <= 0) return;
+                if (eb_cut && S(i, j, k) <= 0) return;
 
                 if (flag_info_cell_dim(i, j, k) == 0) {
                     return;
@@ -354,8 +346,8 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 #else
@@ -383,7 +375,7 @@ void FiniteDifferenceSolver::EvolveBCylindrical (
         {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         // Extract field data for this grid/tile
         Array4<Real> const& Br = Bfield[0]->array(mfi);
@@ -475,8 +467,8 @@ void FiniteDifferenceSolver::EvolveBCylindrical (
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
@@ -16,6 +16,7 @@
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
 #include <AMReX.H>
@@ -113,11 +114,19 @@ void FiniteDifferenceSolver::EvolveECartesian (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+#ifdef AMREX_USE_EB
+        // Skip the tiles that are fully covered by embedded boundaries
+        // (unless the grad(F) correction, applied also in covered cells, is needed)
+        // and only check the edge lengths cell by cell in the cut tiles
+        int const eb_tile_type = GetEBTileType(mfi);
+        if (eb_tile_type == EBTileType::Covered && !Ffield) continue;
+        bool const eb_cut = (eb_tile_type != EBTileType::Regular);
+#endif
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         // Extract field data for this grid/tile
         Array4<Real> const& Ex = Efield[0]->array(mfi);
@@ -144,6 +153,13 @@ void FiniteDifferenceSolver::EvolveECartesian (
         Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
         int const n_coefs_z = m_stencil_coefs_z.size();
 
+        // If F is not a null pointer, E is further updated using the grad(F) term
+        // (hyperbolic correction for errors in charge conservation), in the same
+        // pass over the cells as the curl(B) and J terms
+        bool const has_F = static_cast<bool>(Ffield);
+        Array4<Real> F;
+        if (has_F) F = Ffield->array(mfi);
+
         // Extract tileboxes for which to loop
         Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
         Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
@@ -153,9 +169,10 @@ void FiniteDifferenceSolver::EvolveECartesian (
         amrex::ParallelFor(tex, tey, tez,
 
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                if (has_F) Ex(i, j, k) += c2 * dt * T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k);
 #ifdef AMREX_USE_EB
                 // Skip field push if this cell is fully covered by embedded boundaries
-                if (lx(i, j, k) <= 0) return;
+                if (eb_cut && lx(i, j, k) <= 0) return;
 #endif
                 Ex(i, j, k) += c2 * dt * (
                     - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
@@ -164,9 +181,10 @@ void FiniteDifferenceSolver::EvolveECartesian (
             },
 
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                if (has_F) Ey(i, j, k) += c2 * dt * T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k);
 #ifdef AMREX_USE_EB
                 // Skip field push if this cell is fully covered by embedded boundaries
-                if (ly(i,j,k) <= 0) return;
+                if (eb_cut && ly(i,j,k) <= 0) return;
 #endif
 
                 Ey(i, j, k) += c2 * dt * (
@@ -176,10 +194,10 @@ void FiniteDifferenceSolver::EvolveECartesian (
             },
 
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
-
+                if (has_F) Ez(i, j, k) += c2 * dt * T_Algo::UpwardDz(F, coefs_z, n_coefs_z, i, j, k);
 #ifdef AMREX_USE_EB
                 // Skip field push if this cell is fully covered by embedded boundaries
-                if (lz(i,j,k) <= 0) return;
+                if (eb_cut && lz(i,j,k) <= 0) return;
 #endif
                 Ez(i, j, k) += c2 * dt * (
                     - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
@@ -189,35 +207,11 @@ void FiniteDifferenceSolver::EvolveECartesian (
 
         );
 
-        // If F is not a null pointer, further update E using the grad(F) term
-        // (hyperbolic correction for errors in charge conservation)
-        if (Ffield) {
-
-            // Extract field data for this grid/tile
-            Array4<Real> F = Ffield->array(mfi);
-
-            // Loop over the cells and update the fields
-            amrex::ParallelFor(tex, tey, tez,
-
-                [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                    Ex(i, j, k) += c2 * dt * T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                    Ey(i, j, k) += c2 * dt * T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                    Ez(i, j, k) += c2 * dt * T_Algo::UpwardDz(F, coefs_z, n_coefs_z, i, j, k);
-                }
-
-            );
-
-        }
-
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 
@@ -244,7 +238,7 @@ void FiniteDifferenceSolver::EvolveECylindrical (
         {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         // Extract field data for this grid/tile
         Array4<Real> const& Er = Efield[0]->array(mfi);
@@ -418,8 +412,8 @@ void FiniteDifferenceSolver::EvolveECylindrical (
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     } // end of loop over grid/tiles
 
@@ -0,0 +1,240 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FiniteDifferenceSolver.H"
+
+#ifndef WARPX_DIM_RZ
+#   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#   include "FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
+#   include "FiniteDifferenceAlgorithms/CartesianNodalAlgorithm.H"
+#endif
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXUtil.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_Config.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_REAL.H>
+
+#include <AMReX_BaseFwd.H>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+using namespace amrex;
+
+namespace
+{
+    /** \brief Return the slab of `bx` at index `m` along the direction `dir`
+     * (an empty box if `m` is not in `bx`)
+     */
+    Box SlabOf (Box const& bx, int const m, int const dir)
+    {
+        if (m < bx.smallEnd(dir) || m > bx.bigEnd(dir)) return Box();
+        Box slab = bx;
+        slab.setSmall(dir, m);
+        slab.setBig(dir, m);
+        return slab;
+    }
+}
+
+/**
+ * \brief Update B by half a timestep, E by a full timestep and B by another
+ * half timestep, in a single sweep over the grids
+ */
+void FiniteDifferenceSolver::EvolveEBFused (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    int lev, amrex::Real const dt ) {
+
+#ifdef WARPX_DIM_RZ
+    amrex::ignore_unused(Efield, Bfield, Jfield, lev, dt);
+    amrex::Abort(Utils::TextMsg::Err("EvolveEBFused: not implemented in RZ geometry"));
+#else
+    if (m_do_nodal) {
+
+        EvolveEBCartesianFused <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else if (m_fdtd_algo == MaxwellSolverAlgo::Yee) {
+
+        EvolveEBCartesianFused <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else if (m_fdtd_algo == MaxwellSolverAlgo::CKC) {
+
+        EvolveEBCartesianFused <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, lev, dt );
+
+    } else {
+        amrex::Abort(Utils::TextMsg::Err("EvolveEBFused: Unknown algorithm"));
+    }
+#endif
+}
+
+
+#ifndef WARPX_DIM_RZ
+
+template<typename T_Algo>
+void FiniteDifferenceSolver::EvolveEBCartesianFused (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    int lev, amrex::Real const dt ) {
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    Real constexpr c2 = PhysConst::c * PhysConst::c;
+    Real const half_dt = 0.5_rt * dt;
+
+    // Radius of the stencil, i.e. number of cells by which each half step
+    // shrinks the region where the fields are up-to-date
+    IntVect const ng = T_Algo::GetMaxGuardCell();
+    // The sweep goes along the last direction
+    int constexpr wd = AMREX_SPACEDIM - 1;
+    int const lag = ng[wd];
+
+    // The guard cells of E and B must be up-to-date over 3 stencil widths,
+    // and those of J over 1 stencil width
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        Efield[0]->nGrowVect().allGE(3*ng) && Bfield[0]->nGrowVect().allGE(3*ng),
+        "EvolveEBFused: E and B need 3 stencil widths of guard cells");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(Jfield[0]->nGrowVect().allGE(ng),
+        "EvolveEBFused: J needs 1 stencil width of guard cells");
+
+    // Loop through the grids: each grid is updated by a single thread, since the
+    // first two steps also update its guard cells (no tiling)
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for ( MFIter mfi(*Bfield[0]); mfi.isValid(); ++mfi ) {
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+        }
+        Real wt = WarpXUtilLoadBalance::CostClock();
+
+        // Extract field data for this grid
+        Array4<Real> const& Ex = Efield[0]->array(mfi);
+        Array4<Real> const& Ey = Efield[1]->array(mfi);
+        Array4<Real> const& Ez = Efield[2]->array(mfi);
+        Array4<Real> const& Bx = Bfield[0]->array(mfi);
+        Array4<Real> const& By = Bfield[1]->array(mfi);
+        Array4<Real> const& Bz = Bfield[2]->array(mfi);
+        Array4<Real> const& jx = Jfield[0]->array(mfi);
+        Array4<Real> const& jy = Jfield[1]->array(mfi);
+        Array4<Real> const& jz = Jfield[2]->array(mfi);
+
+        // Extract stencil coefficients
+        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+        int const n_coefs_x = m_stencil_coefs_x.size();
+        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+        int const n_coefs_y = m_stencil_coefs_y.size();
+        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+        int const n_coefs_z = m_stencil_coefs_z.size();
+
+        // Regions updated by each step: B^{n+1/2} over 2 stencil widths of guard cells,
+        // E^{n+1} over 1 stencil width, and B^{n+1} over the valid cells only
+        Box const cbx = amrex::enclosedCells(mfi.validbox());
+        std::array<std::array<Box,3>,3> region;
+        for (int idir = 0; idir < 3; ++idir) {
+            region[0][idir] = amrex::grow(amrex::convert(cbx, Bfield[idir]->ixType()), 2*ng);
+            region[1][idir] = amrex::grow(amrex::convert(cbx, Efield[idir]->ixType()), ng);
+            region[2][idir] = amrex::convert(cbx, Bfield[idir]->ixType());
+        }
+
+        // On CPU, the three steps are applied slab by slab along the last direction,
+        // step s lagging s stencil widths behind the first one, so that the
+        // values it reads are still in cache and already (and not yet further) updated.
+        // On GPU, each step is applied to its whole region at once.
+        bool const blocked = amrex::Gpu::notInLaunchRegion();
+        int m_begin = region[0][0].smallEnd(wd);
+        int m_end = m_begin;
+        for (int step = 0; step < 3; ++step) {
+            for (int idir = 0; idir < 3; ++idir) {
+                m_begin = std::min(m_begin, region[step][idir].smallEnd(wd) + step*lag);
+                m_end = std::max(m_end, region[step][idir].bigEnd(wd) + step*lag);
+            }
+        }
+        if (!blocked) m_end = m_begin;
+
+        for (int m = m_begin; m <= m_end; ++m) {
+            for (int step = 0; step < 3; ++step) {
+
+                std::array<Box,3> tb = region[step];
+                if (blocked) {
+                    for (auto& bx : tb) bx = SlabOf(bx, m - step*lag, wd);
+                }
+
+                if (step == 1) {
+                    // E^{n+1} from B^{n+1/2} and J^{n+1/2}
+                    amrex::ParallelFor(tb[0], tb[1], tb[2],
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            Ex(i, j, k) += c2 * dt * (
+                                - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
+                                + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
+                                - PhysConst::mu0 * jx(i, j, k) );
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            Ey(i, j, k) += c2 * dt * (
+                                - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
+                                + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
+                                - PhysConst::mu0 * jy(i, j, k) );
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            Ez(i, j, k) += c2 * dt * (
+                                - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
+                                + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
+                                - PhysConst::mu0 * jz(i, j, k) );
+                        }
+                    );
+                } else {
+                    // B^{n+1/2} from E^{n}, or B^{n+1} from E^{n+1}
+                    amrex::ParallelFor(tb[0], tb[1], tb[2],
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            Bx(i, j, k) += half_dt * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
+                                         - half_dt * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            By(i, j, k) += half_dt * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
+                                         - half_dt * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
+                        },
+
+                        [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                            Bz(i, j, k) += half_dt * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
+                                         - half_dt * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
+                        }
+                    );
+                }
+            }
+        }
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
+        }
+    }
+}
+
+#endif // corresponds to ifndef WARPX_DIM_RZ
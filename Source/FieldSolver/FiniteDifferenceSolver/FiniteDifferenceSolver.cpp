@@ -20,10 +20,16 @@
 #endif
 
 #include <AMReX.H>
+#include <AMReX_Array4.H>
 #include <AMReX_GpuDevice.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
 #include <AMReX_PODVector.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_Vector.H>
 
+#include <array>
+#include <memory>
 #include <vector>
 
 /* This function initializes the stencil coefficients for the chosen finite-difference algorithm */
@@ -98,3 +104,89 @@ FiniteDifferenceSolver::FiniteDifferenceSolver (
     amrex::Gpu::synchronize();
 #endif
 }
+
+#ifdef AMREX_USE_EB
+namespace
+{
+    /** \brief EBTileType of each tile of the MultiFabs `lengths` (edge lengths or
+     * face areas), indexed by MFIter::LocalTileIndex
+     *
+     * \param[in] lengths edge lengths or face areas, for the three components
+     * \param[in] do_tiling whether the tiles are those of a tiled MFIter (if not on GPU)
+     */
+    amrex::Vector<int> ClassifyTiles (
+        std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& lengths, bool const do_tiling)
+    {
+        // Number of tiles, as seen by an MFIter over the field MultiFabs
+        // (outside of an OpenMP parallel region, so that it includes all the tiles)
+        bool const tiling = do_tiling && amrex::TilingIfNotGPU();
+        int const n_tiles = amrex::MFIter(*lengths[0], tiling).length();
+        amrex::Vector<int> tile_types(n_tiles, EBTileType::Cut);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for ( amrex::MFIter mfi(*lengths[0], tiling); mfi.isValid(); ++mfi ) {
+
+            // Count the uncovered edges (faces) of the tile, for the three components
+            amrex::Long n_edges = 0;
+            amrex::Long n_uncovered = 0;
+            for (int idim = 0; idim < 3; ++idim) {
+                amrex::Box const& tb = mfi.tilebox(lengths[idim]->ixType().toIntVect());
+                amrex::Array4<amrex::Real const> const& l = lengths[idim]->const_array(mfi);
+
+                amrex::ReduceOps<amrex::ReduceOpSum> reduce_op;
+                amrex::ReduceData<amrex::Long> reduce_data(reduce_op);
+                reduce_op.eval(tb, reduce_data,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k) -> amrex::GpuTuple<amrex::Long>
+                    {
+                        return {(l(i, j, k) > 0) ? 1 : 0};
+                    });
+                n_uncovered += amrex::get<0>(reduce_data.value(reduce_op));
+                n_edges += tb.numPts();
+            }
+
+            int tile_type = EBTileType::Cut;
+            if (n_uncovered == 0) {
+                tile_type = EBTileType::Covered;
+            } else if (n_uncovered == n_edges) {
+                tile_type = EBTileType::Regular;
+            }
+            tile_types[mfi.LocalTileIndex()] = tile_type;
+        }
+        return tile_types;
+    }
+
+    /** Return the EBTileType of the current tile in `tile_types` (EBTileType::Cut if not classified) */
+    int GetTileType (amrex::Vector<int> const& tile_types, amrex::MFIter const& mfi)
+    {
+        int const itile = mfi.LocalTileIndex();
+        if (itile < static_cast<int>(tile_types.size())) {
+            return tile_types[itile];
+        }
+        return EBTileType::Cut;
+    }
+}
+
+void
+FiniteDifferenceSolver::ClassifyEBTiles (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& edge_lengths,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& face_areas)
+{
+    m_eb_tile_type = ClassifyTiles(edge_lengths, true);
+    // The ECT B-field push loops over the grids without tiling
+    m_eb_face_tile_type = ClassifyTiles(face_areas, false);
+}
+
+int
+FiniteDifferenceSolver::GetEBTileType (amrex::MFIter const& mfi) const
+{
+    return GetTileType(m_eb_tile_type, mfi);
+}
+
+int
+FiniteDifferenceSolver::GetEBFaceTileType (amrex::MFIter const& mfi) const
+{
+    return GetTileType(m_eb_face_tile_type, mfi);
+}
+#endif
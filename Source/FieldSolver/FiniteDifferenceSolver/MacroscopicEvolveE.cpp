@@ -8,7 +8,6 @@
 #   include "FiniteDifferenceAlgorithms/FieldAccessorFunctors.H"
 #endif
 #include "MacroscopicProperties/MacroscopicProperties.H"
-#include "Utils/CoarsenIO.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
@@ -53,6 +52,9 @@ void FiniteDifferenceSolver::MacroscopicEvolveE (
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         !m_do_nodal, "macro E-push does not work for nodal");
 
+    // The coefficients alpha and beta only depend on the medium and on dt:
+    // this is a no-op unless they have not been computed yet for this dt
+    macroscopic_properties->ComputeUpdateCoefficients(Efield, dt);
 
     if (m_fdtd_algo == MaxwellSolverAlgo::Yee) {
 
@@ -108,25 +110,28 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
 #ifndef AMREX_USE_EB
     amrex::ignore_unused(edge_lengths);
 #endif
+    // dt only enters through the precomputed coefficients alpha and beta
+    amrex::ignore_unused(dt);
 
-    amrex::MultiFab& sigma_mf = macroscopic_properties->getsigma_mf();
-    amrex::MultiFab& epsilon_mf = macroscopic_properties->getepsilon_mf();
     amrex::MultiFab& mu_mf = macroscopic_properties->getmu_mf();
 
-    // Index type required for calling CoarsenIO::Interp to interpolate macroscopic
-    // properties from their respective staggering to the Ex, Ey, Ez locations
-    amrex::GpuArray<int, 3> const& sigma_stag = macroscopic_properties->sigma_IndexType;
-    amrex::GpuArray<int, 3> const& epsilon_stag = macroscopic_properties->epsilon_IndexType;
-    amrex::GpuArray<int, 3> const& macro_cr     = macroscopic_properties->macro_cr_ratio;
-    amrex::GpuArray<int, 3> const& Ex_stag = macroscopic_properties->Ex_IndexType;
-    amrex::GpuArray<int, 3> const& Ey_stag = macroscopic_properties->Ey_IndexType;
-    amrex::GpuArray<int, 3> const& Ez_stag = macroscopic_properties->Ez_IndexType;
+    // Coefficients (alpha, beta) of the E-update, precomputed at the Ex, Ey, Ez locations
+    amrex::MultiFab& coefs_Ex_mf = macroscopic_properties->getcoefs_mf(0);
+    amrex::MultiFab& coefs_Ey_mf = macroscopic_properties->getcoefs_mf(1);
+    amrex::MultiFab& coefs_Ez_mf = macroscopic_properties->getcoefs_mf(2);
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+#ifdef AMREX_USE_EB
+        // Skip the tiles that are fully covered by embedded boundaries
+        // and only check the edge lengths cell by cell in the cut tiles
+        int const eb_tile_type = GetEBTileType(mfi);
+        if (eb_tile_type == EBTileType::Covered) continue;
+        bool const eb_cut = (eb_tile_type != EBTileType::Regular);
+#endif
 
         // Extract field data for this grid/tile
         Array4<Real> const& Ex = Efield[0]->array(mfi);
@@ -146,9 +151,10 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
 #endif
 
         // material prop //
-        amrex::Array4<amrex::Real> const& sigma_arr = sigma_mf.array(mfi);
-        amrex::Array4<amrex::Real> const& eps_arr = epsilon_mf.array(mfi);
         amrex::Array4<amrex::Real> const& mu_arr = mu_mf.array(mfi);
+        amrex::Array4<amrex::Real const> const& coefs_Ex = coefs_Ex_mf.const_array(mfi);
+        amrex::Array4<amrex::Real const> const& coefs_Ey = coefs_Ey_mf.const_array(mfi);
+        amrex::Array4<amrex::Real const> const& coefs_Ez = coefs_Ez_mf.const_array(mfi);
 
         // Extract stencil coefficients
         Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
@@ -169,23 +175,15 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
         Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
         Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
         Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
-        // starting component to interpolate macro properties to Ex, Ey, Ez locations
-        const int scomp = 0;
         // Loop over the cells and update the fields
         amrex::ParallelFor(tex, tey, tez,
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
                 // Skip field push if this cell is fully covered by embedded boundaries
-                if (lx(i, j, k) <= 0) return;
+                if (eb_cut && lx(i, j, k) <= 0) return;
 #endif
-                // Interpolate conductivity, sigma, to Ex position on the grid
-                amrex::Real const sigma_interp = CoarsenIO::Interp( sigma_arr, sigma_stag,
-                                           Ex_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ex position on the grid
-                amrex::Real const epsilon_interp = CoarsenIO::Interp( eps_arr, epsilon_stag,
-                                           Ex_stag, macro_cr, i, j, k, scomp);
-                amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
+                amrex::Real const alpha = coefs_Ex(i, j, k, 0);
+                amrex::Real const beta = coefs_Ex(i, j, k, 1);
                 Ex(i, j, k) = alpha * Ex(i, j, k)
                             + beta * ( - T_Algo::DownwardDz(Hy, coefs_z, n_coefs_z, i, j, k,0)
                                        + T_Algo::DownwardDy(Hz, coefs_y, n_coefs_y, i, j, k,0)
@@ -195,17 +193,10 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
                 // Skip field push if this cell is fully covered by embedded boundaries
-                if (ly(i,j,k) <= 0) return;
+                if (eb_cut && ly(i,j,k) <= 0) return;
 #endif
-                // Interpolate conductivity, sigma, to Ey position on the grid
-                amrex::Real const sigma_interp = CoarsenIO::Interp( sigma_arr, sigma_stag,
-                                           Ey_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ey position on the grid
-                amrex::Real const epsilon_interp = CoarsenIO::Interp( eps_arr, epsilon_stag,
-                                           Ey_stag, macro_cr, i, j, k, scomp);
-                amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
-
+                amrex::Real const alpha = coefs_Ey(i, j, k, 0);
+                amrex::Real const beta = coefs_Ey(i, j, k, 1);
                 Ey(i, j, k) = alpha * Ey(i, j, k)
                             + beta * ( - T_Algo::DownwardDx(Hz, coefs_x, n_coefs_x, i, j, k,0)
                                        + T_Algo::DownwardDz(Hx, coefs_z, n_coefs_z, i, j, k,0)
@@ -215,17 +206,10 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
                 // Skip field push if this cell is fully covered by embedded boundaries
-                if (lz(i,j,k) <= 0) return;
+                if (eb_cut && lz(i,j,k) <= 0) return;
 #endif
-                // Interpolate conductivity, sigma, to Ez position on the grid
-                amrex::Real const sigma_interp = CoarsenIO::Interp( sigma_arr, sigma_stag,
-                                           Ez_stag, macro_cr, i, j, k, scomp);
-                // Interpolated permittivity, epsilon, to Ez position on the grid
-                amrex::Real const epsilon_interp = CoarsenIO::Interp( eps_arr, epsilon_stag,
-                                           Ez_stag, macro_cr, i, j, k, scomp);
-                amrex::Real alpha = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
-                amrex::Real beta = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
-
+                amrex::Real const alpha = coefs_Ez(i, j, k, 0);
+                amrex::Real const beta = coefs_Ez(i, j, k, 1);
                 Ez(i, j, k) = alpha * Ez(i, j, k)
                             + beta * ( - T_Algo::DownwardDy(Hx, coefs_y, n_coefs_y, i, j, k,0)
                                        + T_Algo::DownwardDx(Hy, coefs_x, n_coefs_x, i, j, k,0)
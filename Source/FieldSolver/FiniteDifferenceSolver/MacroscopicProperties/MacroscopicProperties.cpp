@@ -1,6 +1,8 @@
 #include "MacroscopicProperties.H"
 
+#include "Utils/CoarsenIO.H"
 #include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
@@ -22,6 +24,7 @@
 
 #include <AMReX_BaseFwd.H>
 
+#include <array>
 #include <memory>
 #include <sstream>
 
@@ -195,6 +198,84 @@ MacroscopicProperties::InitData ()
         Ez_IndexType[2]      = 0;
         macro_cr_ratio[2]    = 1;
 #endif
+
+    // The material properties were (re)initialized: the E-update coefficients
+    // need to be recomputed
+    m_coefs_valid = false;
+}
+
+void
+MacroscopicProperties::ComputeUpdateCoefficients (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Efield,
+    amrex::Real dt)
+{
+    // Check whether the stored coefficients can be reused
+    bool same_layout = true;
+    for (int idim = 0; idim < 3; ++idim) {
+        same_layout = same_layout && m_coefs_mf[idim]
+            && m_coefs_mf[idim]->boxArray() == Efield[idim]->boxArray()
+            && m_coefs_mf[idim]->DistributionMap() == Efield[idim]->DistributionMap();
+    }
+    if (m_coefs_valid && same_layout && m_coefs_dt == dt) return;
+
+    if (!same_layout) {
+        // Two components per location: alpha and beta
+        for (int idim = 0; idim < 3; ++idim) {
+            m_coefs_mf[idim] = std::make_unique<amrex::MultiFab>(
+                Efield[idim]->boxArray(), Efield[idim]->DistributionMap(), 2, 0);
+        }
+    }
+
+    if (WarpX::macroscopic_solver_algo == MacroscopicSolverAlgo::LaxWendroff) {
+        ComputeUpdateCoefficientsTemplate<LaxWendroffAlgo>(dt);
+    } else if (WarpX::macroscopic_solver_algo == MacroscopicSolverAlgo::BackwardEuler) {
+        ComputeUpdateCoefficientsTemplate<BackwardEulerAlgo>(dt);
+    } else {
+        amrex::Abort(Utils::TextMsg::Err(
+            "ComputeUpdateCoefficients: Unknown macroscopic solver algorithm"));
+    }
+
+    m_coefs_dt = dt;
+    m_coefs_valid = true;
+}
+
+template<typename T_MacroAlgo>
+void
+MacroscopicProperties::ComputeUpdateCoefficientsTemplate (amrex::Real dt)
+{
+    // Index types required for calling CoarsenIO::Interp to interpolate macroscopic
+    // properties from their respective staggering to the Ex, Ey, Ez locations
+    amrex::GpuArray<int, 3> const& sigma_stag = sigma_IndexType;
+    amrex::GpuArray<int, 3> const& epsilon_stag = epsilon_IndexType;
+    amrex::GpuArray<int, 3> const& macro_cr = macro_cr_ratio;
+    std::array< amrex::GpuArray<int, 3>, 3 > const E_stag = {Ex_IndexType, Ey_IndexType, Ez_IndexType};
+    // starting component to interpolate macro properties to Ex, Ey, Ez locations
+    const int scomp = 0;
+
+    for (int idim = 0; idim < 3; ++idim) {
+        amrex::GpuArray<int, 3> const& Ecomp_stag = E_stag[idim];
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for ( amrex::MFIter mfi(*m_coefs_mf[idim], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
+
+            amrex::Array4<amrex::Real const> const& sigma_arr = m_sigma_mf->const_array(mfi);
+            amrex::Array4<amrex::Real const> const& eps_arr = m_eps_mf->const_array(mfi);
+            amrex::Array4<amrex::Real> const& coefs = m_coefs_mf[idim]->array(mfi);
+
+            amrex::ParallelFor(mfi.tilebox(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                    // Interpolate conductivity, sigma, and permittivity, epsilon,
+                    // to the E-field position on the grid
+                    amrex::Real const sigma_interp = CoarsenIO::Interp( sigma_arr, sigma_stag,
+                                               Ecomp_stag, macro_cr, i, j, k, scomp);
+                    amrex::Real const epsilon_interp = CoarsenIO::Interp( eps_arr, epsilon_stag,
+                                               Ecomp_stag, macro_cr, i, j, k, scomp);
+                    coefs(i, j, k, 0) = T_MacroAlgo::alpha( sigma_interp, epsilon_interp, dt);
+                    coefs(i, j, k, 1) = T_MacroAlgo::beta( sigma_interp, epsilon_interp, dt);
+                });
+        }
+    }
 }
 
 void
@@ -27,6 +27,85 @@
 
 using namespace amrex;
 
+namespace
+{
+    /**
+     * \brief Coefficients of the standard PSATD update equations (zero Galilean velocity),
+     *        which are all real-valued
+     */
+    struct StandardPsatdCoefficients
+    {
+        amrex::Real C, S_ck, X1, X2, X3;
+    };
+
+    /**
+     * \brief Compute the coefficients of the standard PSATD update equations for a given
+     *        norm of the k vector, as in PsatdAlgorithm::InitializeSpectralCoefficients with w_c = 0
+     *
+     * \param[in] knorm norm of the modified k vector
+     * \param[in] dt time step of the simulation
+     * \param[in] update_with_rho whether the update equation for E uses rho or not
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    StandardPsatdCoefficients ComputeStandardPsatdCoefficients (
+        const amrex::Real knorm, const amrex::Real dt, const bool update_with_rho)
+    {
+        constexpr amrex::Real c = PhysConst::c;
+        constexpr amrex::Real ep0 = PhysConst::ep0;
+
+        const amrex::Real c2 = c * c;
+        const amrex::Real dt2 = dt * dt;
+
+        const amrex::Real om_s = c * knorm;
+        const amrex::Real om2_s = om_s * om_s;
+
+        StandardPsatdCoefficients coefs;
+
+        coefs.C = std::cos(om_s * dt);
+
+        if (om_s != 0.)
+        {
+            coefs.S_ck = std::sin(om_s * dt) / om_s;
+            coefs.X1 = (1._rt - coefs.C) / (ep0 * om2_s);
+        }
+        else // om_s = 0
+        {
+            coefs.S_ck = dt;
+            coefs.X1 = 0.5_rt * dt2 / ep0;
+        }
+
+        if (update_with_rho)
+        {
+            if (om_s != 0.)
+            {
+                coefs.X2 = c2 * (dt - coefs.S_ck) / (ep0 * dt * om2_s);
+                coefs.X3 = c2 * (dt * coefs.C - coefs.S_ck) / (ep0 * dt * om2_s);
+            }
+            else // om_s = 0
+            {
+                coefs.X2 = c2 * dt2 / (6._rt * ep0);
+                coefs.X3 = - c2 * dt2 / (3._rt * ep0);
+            }
+        }
+        else // update_with_rho = 0
+        {
+            // X1 is equal to the auxiliary variable tmp of InitializeSpectralCoefficients
+            coefs.X2 = c2 * ep0 * coefs.X1;
+
+            if (om_s != 0.)
+            {
+                coefs.X3 = c2 * (coefs.S_ck - dt) / (ep0 * om2_s);
+            }
+            else // om_s = 0
+            {
+                coefs.X3 = - c2 * dt2 * dt / (6._rt * ep0);
+            }
+        }
+
+        return coefs;
+    }
+}
+
 PsatdAlgorithm::PsatdAlgorithm(
     const SpectralKSpace& spectral_kspace,
     const DistributionMapping& dm,
@@ -41,7 +120,8 @@ PsatdAlgorithm::PsatdAlgorithm(
     const bool update_with_rho,
     const bool time_averaging,
     const bool dive_cleaning,
-    const bool divb_cleaning)
+    const bool divb_cleaning,
+    const bool on_the_fly_coefficients)
     // Initializer list
     : SpectralBaseAlgorithm(spectral_kspace, dm, spectral_index, norder_x, norder_y, norder_z, nodal, fill_guards),
     m_spectral_index(spectral_index),
@@ -60,27 +140,36 @@ PsatdAlgorithm::PsatdAlgorithm(
     m_update_with_rho(update_with_rho),
     m_time_averaging(time_averaging),
     m_dive_cleaning(dive_cleaning),
-    m_divb_cleaning(divb_cleaning)
+    m_divb_cleaning(divb_cleaning),
+    m_on_the_fly_coefficients(on_the_fly_coefficients)
 {
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
     m_is_galilean = (v_galilean[0] != 0.) || (v_galilean[1] != 0.) || (v_galilean[2] != 0.);
 
-    // Always allocate these coefficients
-    C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
-    X1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    X3_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !on_the_fly_coefficients || (!m_is_galilean && !time_averaging),
+        "psatd.on_the_fly_coefficients = 1 is implemented only for the standard PSATD algorithm"
+    );
 
-    // Allocate these coefficients only with Galilean PSATD
-    if (m_is_galilean)
+    // Allocate these coefficients, unless they are computed on the fly
+    if (!on_the_fly_coefficients)
     {
-        X4_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-        T2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
-    }
+        C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+        S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
+        X1_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+        X2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+        X3_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+
+        // Allocate these coefficients only with Galilean PSATD
+        if (m_is_galilean)
+        {
+            X4_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+            T2_coef = SpectralComplexCoefficients(ba, dm, 1, 0);
+        }
 
-    InitializeSpectralCoefficients(spectral_kspace, dm, dt);
+        InitializeSpectralCoefficients(spectral_kspace, dm, dt);
+    }
 
     // Allocate these coefficients only with time averaging
     if (time_averaging)
@@ -112,6 +201,20 @@ PsatdAlgorithm::PsatdAlgorithm(
 
 void
 PsatdAlgorithm::pushSpectralFields (SpectralFieldData& f) const
+{
+    if (m_on_the_fly_coefficients)
+    {
+        pushSpectralFieldsTemplate<true>(f);
+    }
+    else
+    {
+        pushSpectralFieldsTemplate<false>(f);
+    }
+}
+
+template <bool T_on_the_fly_coefficients>
+void
+PsatdAlgorithm::pushSpectralFieldsTemplate (SpectralFieldData& f) const
 {
     const bool update_with_rho = m_update_with_rho;
     const bool time_averaging  = m_time_averaging;
@@ -131,12 +234,20 @@ PsatdAlgorithm::pushSpectralFields (SpectralFieldData& f) const
         // Extract arrays for the fields to be updated
         amrex::Array4<Complex> fields = f.fields[mfi].array();
 
-        // These coefficients are always allocated
-        amrex::Array4<const amrex::Real> C_arr = C_coef[mfi].array();
-        amrex::Array4<const amrex::Real> S_ck_arr = S_ck_coef[mfi].array();
-        amrex::Array4<const Complex> X1_arr = X1_coef[mfi].array();
-        amrex::Array4<const Complex> X2_arr = X2_coef[mfi].array();
-        amrex::Array4<const Complex> X3_arr = X3_coef[mfi].array();
+        // These coefficients are always allocated, unless they are computed on the fly
+        amrex::Array4<const amrex::Real> C_arr;
+        amrex::Array4<const amrex::Real> S_ck_arr;
+        amrex::Array4<const Complex> X1_arr;
+        amrex::Array4<const Complex> X2_arr;
+        amrex::Array4<const Complex> X3_arr;
+        if constexpr (!T_on_the_fly_coefficients)
+        {
+            C_arr = C_coef[mfi].array();
+            S_ck_arr = S_ck_coef[mfi].array();
+            X1_arr = X1_coef[mfi].array();
+            X2_arr = X2_coef[mfi].array();
+            X3_arr = X3_coef[mfi].array();
+        }
 
         amrex::Array4<const Complex> X4_arr;
         amrex::Array4<const Complex> T2_arr;
@@ -186,8 +297,9 @@ PsatdAlgorithm::pushSpectralFields (SpectralFieldData& f) const
             const Complex Jx = fields(i,j,k,Idx.Jx);
             const Complex Jy = fields(i,j,k,Idx.Jy);
             const Complex Jz = fields(i,j,k,Idx.Jz);
-            const Complex rho_old = fields(i,j,k,Idx.rho_old);
-            const Complex rho_new = fields(i,j,k,Idx.rho_new);
+            // (rho is allocated in spectral space only when it is used)
+            const Complex rho_old = (update_with_rho) ? fields(i,j,k,Idx.rho_old) : Complex{0._rt, 0._rt};
+            const Complex rho_new = (update_with_rho) ? fields(i,j,k,Idx.rho_new) : Complex{0._rt, 0._rt};
 
             Complex F_old;
             if (dive_cleaning)
@@ -215,12 +327,28 @@ PsatdAlgorithm::pushSpectralFields (SpectralFieldData& f) const
             constexpr Real inv_ep0 = 1._rt / PhysConst::ep0;
             constexpr Complex I = Complex{0._rt, 1._rt};
 
-            // These coefficients are initialized in the function InitializeSpectralCoefficients
-            const amrex::Real C = C_arr(i,j,k);
-            const amrex::Real S_ck = S_ck_arr(i,j,k);
-            const Complex X1 = X1_arr(i,j,k);
-            const Complex X2 = X2_arr(i,j,k);
-            const Complex X3 = X3_arr(i,j,k);
+            // These coefficients are initialized in the function InitializeSpectralCoefficients,
+            // or computed here from the norm of the k vector for standard PSATD
+            amrex::Real C, S_ck;
+            Complex X1, X2, X3;
+            if constexpr (T_on_the_fly_coefficients)
+            {
+                const amrex::Real knorm = std::sqrt(kx * kx + ky * ky + kz * kz);
+                const auto coefs = ComputeStandardPsatdCoefficients(knorm, dt, update_with_rho);
+                C = coefs.C;
+                S_ck = coefs.S_ck;
+                X1 = coefs.X1;
+                X2 = coefs.X2;
+                X3 = coefs.X3;
+            }
+            else
+            {
+                C = C_arr(i,j,k);
+                S_ck = S_ck_arr(i,j,k);
+                X1 = X1_arr(i,j,k);
+                X2 = X2_arr(i,j,k);
+                X3 = X3_arr(i,j,k);
+            }
             const Complex X4 = (is_galilean) ? X4_arr(i,j,k) : - S_ck / PhysConst::ep0;
             const Complex T2 = (is_galilean) ? T2_arr(i,j,k) : 1.0_rt;
 
@@ -895,4 +1023,36 @@ PsatdAlgorithm::VayDeposition (SpectralFieldData& field_data)
     }
 }
 
+
+void
+PsatdAlgorithm::RemakeDistributionMapping (const amrex::DistributionMapping& dm)
+{
+    SpectralBaseAlgorithm::RemakeDistributionMapping(dm);
+
+    RedistributeKVector(modified_kx_vec_centered, 0, dm);
+#if defined(WARPX_DIM_3D)
+    RedistributeKVector(modified_ky_vec_centered, 1, dm);
+    RedistributeKVector(modified_kz_vec_centered, 2, dm);
+#else
+    RedistributeKVector(modified_kz_vec_centered, 1, dm);
+#endif
+
+    // Not allocated when computed on the fly
+    RedistributeCoefficients(C_coef, dm);
+    RedistributeCoefficients(S_ck_coef, dm);
+    RedistributeCoefficients(T2_coef, dm);
+    RedistributeCoefficients(X1_coef, dm);
+    RedistributeCoefficients(X2_coef, dm);
+    RedistributeCoefficients(X3_coef, dm);
+    RedistributeCoefficients(X4_coef, dm);
+
+    // Allocated only with averaged Galilean PSATD
+    RedistributeCoefficients(Psi1_coef, dm);
+    RedistributeCoefficients(Psi2_coef, dm);
+    RedistributeCoefficients(Y1_coef, dm);
+    RedistributeCoefficients(Y2_coef, dm);
+    RedistributeCoefficients(Y3_coef, dm);
+    RedistributeCoefficients(Y4_coef, dm);
+}
+
 #endif // WARPX_USE_PSATD
@@ -505,4 +505,27 @@ PsatdAlgorithmComoving::VayDeposition (SpectralFieldData& /*field_data*/)
         "Vay deposition not implemented for comoving PSATD"));
 }
 
+
+void
+PsatdAlgorithmComoving::RemakeDistributionMapping (const amrex::DistributionMapping& dm)
+{
+    SpectralBaseAlgorithm::RemakeDistributionMapping(dm);
+
+    RedistributeKVector(kx_vec, 0, dm);
+#if defined(WARPX_DIM_3D)
+    RedistributeKVector(ky_vec, 1, dm);
+    RedistributeKVector(kz_vec, 2, dm);
+#else
+    RedistributeKVector(kz_vec, 1, dm);
+#endif
+
+    RedistributeCoefficients(C_coef, dm);
+    RedistributeCoefficients(S_ck_coef, dm);
+    RedistributeCoefficients(Theta2_coef, dm);
+    RedistributeCoefficients(X1_coef, dm);
+    RedistributeCoefficients(X2_coef, dm);
+    RedistributeCoefficients(X3_coef, dm);
+    RedistributeCoefficients(X4_coef, dm);
+}
+
 #endif // WARPX_USE_PSATD
@@ -445,4 +445,20 @@ PsatdAlgorithmJLinearInTime::VayDeposition (SpectralFieldData& field_data)
         "Vay deposition not implemented for multi-J PSATD algorithm"));
 }
 
+
+void
+PsatdAlgorithmJLinearInTime::RemakeDistributionMapping (const amrex::DistributionMapping& dm)
+{
+    SpectralBaseAlgorithm::RemakeDistributionMapping(dm);
+
+    RedistributeCoefficients(C_coef, dm);
+    RedistributeCoefficients(S_ck_coef, dm);
+    RedistributeCoefficients(X1_coef, dm);
+    RedistributeCoefficients(X2_coef, dm);
+    RedistributeCoefficients(X3_coef, dm);
+    // Allocated only with time averaging
+    RedistributeCoefficients(X5_coef, dm);
+    RedistributeCoefficients(X6_coef, dm);
+}
+
 #endif // WARPX_USE_PSATD
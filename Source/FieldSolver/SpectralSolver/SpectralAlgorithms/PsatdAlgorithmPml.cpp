@@ -416,4 +416,15 @@ PsatdAlgorithmPml::VayDeposition (SpectralFieldData& /*field_data*/)
         "Vay deposition not implemented for PML PSATD"));
 }
 
+
+void
+PsatdAlgorithmPml::RemakeDistributionMapping (const amrex::DistributionMapping& dm)
+{
+    SpectralBaseAlgorithm::RemakeDistributionMapping(dm);
+
+    RedistributeCoefficients(C_coef, dm);
+    RedistributeCoefficients(S_ck_coef, dm);
+    RedistributeCoefficients(inv_k2_coef, dm);
+}
+
 #endif // WARPX_USE_PSATD
@@ -173,3 +173,13 @@ PsatdAlgorithmPmlRZ::VayDeposition (SpectralFieldDataRZ& /*field_data*/)
     amrex::Abort(Utils::TextMsg::Err(
         "Vay deposition not implemented in RZ geometry PML"));
 }
+
+void
+PsatdAlgorithmPmlRZ::RemakeDistributionMapping (const amrex::DistributionMapping& dm)
+{
+    SpectralBaseAlgorithmRZ::RemakeDistributionMapping(dm);
+
+    // The coefficients are computed at the first push: before that, there is no data to send
+    RedistributeCoefficients(C_coef, dm, coefficients_initialized);
+    RedistributeCoefficients(S_ck_coef, dm, coefficients_initialized);
+}
@@ -153,8 +153,9 @@ PsatdAlgorithmRZ::pushSpectralFields(SpectralFieldDataRZ & f)
             Complex const Jp = fields(i,j,k,Jp_m);
             Complex const Jm = fields(i,j,k,Jm_m);
             Complex const Jz = fields(i,j,k,Jz_m);
-            Complex const rho_old = fields(i,j,k,rho_old_m);
-            Complex const rho_new = fields(i,j,k,rho_new_m);
+            // (rho is allocated in spectral space only when it is used)
+            Complex const rho_old = (update_with_rho) ? fields(i,j,k,rho_old_m) : Complex{0._rt, 0._rt};
+            Complex const rho_new = (update_with_rho) ? fields(i,j,k,rho_new_m) : Complex{0._rt, 0._rt};
 
             int Ep_avg_m;
             int Em_avg_m;
@@ -488,3 +489,18 @@ PsatdAlgorithmRZ::VayDeposition (SpectralFieldDataRZ& /*field_data*/)
     amrex::Abort(Utils::TextMsg::Err(
         "Vay deposition not implemented in RZ geometry"));
 }
+
+void
+PsatdAlgorithmRZ::RemakeDistributionMapping (const amrex::DistributionMapping& dm)
+{
+    SpectralBaseAlgorithmRZ::RemakeDistributionMapping(dm);
+
+    // The coefficients are computed at the first push: before that, there is no data to send
+    RedistributeCoefficients(C_coef, dm, coefficients_initialized);
+    RedistributeCoefficients(S_ck_coef, dm, coefficients_initialized);
+    RedistributeCoefficients(X1_coef, dm, coefficients_initialized);
+    RedistributeCoefficients(X2_coef, dm, coefficients_initialized);
+    RedistributeCoefficients(X3_coef, dm, coefficients_initialized);
+    RedistributeCoefficients(X5_coef, dm, coefficients_initialized);
+    RedistributeCoefficients(X6_coef, dm, coefficients_initialized);
+}
@@ -11,7 +11,9 @@
 
 #include <AMReX_Array4.H>
 #include <AMReX_BaseFab.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuComplex.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
@@ -21,6 +23,7 @@
 
 #include <array>
 #include <memory>
+#include <utility>
 
 using namespace amrex;
 
@@ -49,6 +52,18 @@ SpectralBaseAlgorithm::SpectralBaseAlgorithm(const SpectralKSpace& spectral_kspa
 #endif
     }
 
+void
+SpectralBaseAlgorithm::RemakeDistributionMapping (const amrex::DistributionMapping& dm)
+{
+    RedistributeKVector(modified_kx_vec, 0, dm);
+#if defined(WARPX_DIM_3D)
+    RedistributeKVector(modified_ky_vec, 1, dm);
+    RedistributeKVector(modified_kz_vec, 2, dm);
+#else
+    RedistributeKVector(modified_kz_vec, 1, dm);
+#endif
+}
+
 /**
  * \brief Compute spectral divergence of E
  */
@@ -10,6 +10,12 @@
 
 using namespace amrex;
 
+void
+SpectralBaseAlgorithmRZ::RemakeDistributionMapping (const amrex::DistributionMapping& dm)
+{
+    RedistributeKVector(modified_kz_vec, 1, dm);
+}
+
 /**
  * \brief Compute spectral divergence of E
  */
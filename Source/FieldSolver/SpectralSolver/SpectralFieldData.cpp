@@ -7,10 +7,13 @@
  */
 #include "SpectralFieldData.H"
 
+#include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
+#include <ablastr/utils/Communication.H>
+
 #include <AMReX_Array4.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
@@ -25,15 +28,23 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_LayoutData.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Periodicity.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
 #if WARPX_USE_PSATD
 
 using namespace amrex;
 
 SpectralFieldIndex::SpectralFieldIndex (const bool update_with_rho,
+                                        const bool current_correction,
                                         const bool time_averaging,
                                         const bool do_multi_J,
                                         const bool dive_cleaning,
@@ -41,9 +52,6 @@ SpectralFieldIndex::SpectralFieldIndex (const bool update_with_rho,
                                         const bool pml,
                                         const bool pml_rz)
 {
-    // TODO Use these to allocate rho_old, rho_new, F, and G only when needed
-    amrex::ignore_unused(update_with_rho);
-
     int c = 0;
 
     if (pml == false)
@@ -52,8 +60,12 @@ SpectralFieldIndex::SpectralFieldIndex (const bool update_with_rho,
         Bx = c++; By = c++; Bz = c++;
         Jx = c++; Jy = c++; Jz = c++;
 
-        // TODO Allocate rho_old and rho_new only when needed
-        rho_old = c++; rho_new = c++;
+        // rho is used in the update equations or to correct the current
+        // (div(E) cleaning and multi-J are implemented only with update_with_rho = 1)
+        if (update_with_rho || current_correction)
+        {
+            rho_old = c++; rho_new = c++;
+        }
 
         // Reuse data corresponding to index Bx = 3 to avoid storing extra memory
         divE = 3;
@@ -110,12 +122,14 @@ SpectralFieldData::SpectralFieldData( const int lev,
                                       const SpectralKSpace& k_space,
                                       const amrex::DistributionMapping& dm,
                                       const int n_field_required,
-                                      const bool periodic_single_box)
+                                      const bool periodic_single_box,
+                                      const bool distributed_fft)
 {
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     bool do_costs = WarpXUtilLoadBalance::doCosts(cost, realspace_ba, dm);
 
     m_periodic_single_box = periodic_single_box;
+    m_distributed_fft = distributed_fft;
 
     const BoxArray& spectralspace_ba = k_space.spectralspace_ba;
 
@@ -125,9 +139,33 @@ SpectralFieldData::SpectralFieldData( const int lev,
 
     // Allocate temporary arrays - in real space and spectral space
     // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // (for a distributed FFT, the FFT library uses its own buffers instead)
+    if (m_distributed_fft == false) {
+        tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
+        tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    }
+
+    InitShiftFactors(k_space, dm);
 
+    if (m_distributed_fft) {
+        InitDistributedFFT(realspace_ba, dm);
+        return;
+    }
+
+    // Allocate and initialize the FFT plans
+    forward_plan = AnyFFT::FFTplans(spectralspace_ba, dm);
+    backward_plan = AnyFFT::FFTplans(spectralspace_ba, dm);
+    // Loop over boxes and allocate the corresponding plan
+    // for each box owned by the local MPI proc
+    for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
+        CreatePlans(lev, realspace_ba, mfi, do_costs);
+    }
+}
+
+void
+SpectralFieldData::InitShiftFactors (const SpectralKSpace& k_space,
+                                     const amrex::DistributionMapping& dm)
+{
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // It the FFT is performed from/to a cell-centered grid in real space,
     // a correcting "shift" factor must be applied in spectral space.
@@ -150,45 +188,135 @@ SpectralFieldData::SpectralFieldData( const int lev,
     zshift_FFTtoCell = k_space.getSpectralShiftFactor(dm, 1,
                                     ShiftType::TransformToCellCentered);
 #endif
+}
 
-    // Allocate and initialize the FFT plans
-    forward_plan = AnyFFT::FFTplans(spectralspace_ba, dm);
-    backward_plan = AnyFFT::FFTplans(spectralspace_ba, dm);
-    // Loop over boxes and allocate the corresponding plan
-    // for each box owned by the local MPI proc
-    for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
-        if (do_costs)
-        {
-            amrex::Gpu::synchronize();
-        }
-        Real wt = amrex::second();
+void
+SpectralFieldData::CreatePlans (const int lev, const amrex::BoxArray& realspace_ba,
+                                const amrex::MFIter& mfi, const bool do_costs)
+{
+    if (do_costs)
+    {
+        amrex::Gpu::synchronize();
+    }
+    Real wt = WarpXUtilLoadBalance::CostClock();
 
-        // Note: the size of the real-space box and spectral-space box
-        // differ when using real-to-complex FFT. When initializing
-        // the FFT plan, the valid dimensions are those of the real-space box.
-        IntVect fft_size = realspace_ba[mfi].length();
+    // Note: the size of the real-space box and spectral-space box
+    // differ when using real-to-complex FFT. When initializing
+    // the FFT plan, the valid dimensions are those of the real-space box.
+    IntVect fft_size = realspace_ba[mfi].length();
 
-        forward_plan[mfi] = AnyFFT::CreatePlan(
-            fft_size, tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<AnyFFT::Complex*>( tmpSpectralField[mfi].dataPtr()),
-            AnyFFT::direction::R2C, AMREX_SPACEDIM);
+    forward_plan[mfi] = AnyFFT::CreatePlan(
+        fft_size, tmpRealField[mfi].dataPtr(),
+        reinterpret_cast<AnyFFT::Complex*>( tmpSpectralField[mfi].dataPtr()),
+        AnyFFT::direction::R2C, AMREX_SPACEDIM);
 
-        backward_plan[mfi] = AnyFFT::CreatePlan(
-            fft_size, tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<AnyFFT::Complex*>( tmpSpectralField[mfi].dataPtr()),
-            AnyFFT::direction::C2R, AMREX_SPACEDIM);
+    backward_plan[mfi] = AnyFFT::CreatePlan(
+        fft_size, tmpRealField[mfi].dataPtr(),
+        reinterpret_cast<AnyFFT::Complex*>( tmpSpectralField[mfi].dataPtr()),
+        AnyFFT::direction::C2R, AMREX_SPACEDIM);
 
-        if (do_costs)
-        {
-            amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+    if (do_costs)
+    {
+        amrex::Gpu::synchronize();
+        wt = WarpXUtilLoadBalance::CostClock() - wt;
+        WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
+    }
+}
+
+void
+SpectralFieldData::RemakeDistributionMapping (const int lev,
+                                              const amrex::BoxArray& realspace_ba,
+                                              const SpectralKSpace& k_space,
+                                              const amrex::DistributionMapping& dm)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_distributed_fft,
+        "SpectralFieldData::RemakeDistributionMapping: not needed with a distributed FFT");
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    bool do_costs = WarpXUtilLoadBalance::doCosts(cost, realspace_ba, dm);
+
+    const BoxArray& spectralspace_ba = k_space.spectralspace_ba;
+    const DistributionMapping old_dm = fields.DistributionMap();
+
+    // The plans of the boxes that leave this MPI rank are destroyed
+    for ( MFIter mfi(spectralspace_ba, old_dm); mfi.isValid(); ++mfi ){
+        if (dm[mfi.index()] != old_dm[mfi.index()]) {
+            AnyFFT::DestroyPlan(forward_plan[mfi]);
+            AnyFFT::DestroyPlan(backward_plan[mfi]);
+        }
+    }
+
+    // The spectral fields and the temporary arrays only hold data within a time step:
+    // the boxes that change owner are allocated on their new owner but not sent.
+    // The boxes that keep their owner keep their memory, and thus their plans.
+    using ablastr::utils::communication::Redistribute;
+    Redistribute(fields, dm, false);
+    Redistribute(tmpRealField, dm, false);
+    Redistribute(tmpSpectralField, dm, false);
+
+    InitShiftFactors(k_space, dm);
+
+    AnyFFT::FFTplans old_forward_plan = std::move(forward_plan);
+    AnyFFT::FFTplans old_backward_plan = std::move(backward_plan);
+    forward_plan = AnyFFT::FFTplans(spectralspace_ba, dm);
+    backward_plan = AnyFFT::FFTplans(spectralspace_ba, dm);
+    for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
+        if (dm[mfi.index()] == old_dm[mfi.index()]) {
+            forward_plan[mfi] = old_forward_plan[mfi.index()];
+            backward_plan[mfi] = old_backward_plan[mfi.index()];
+        } else {
+            CreatePlans(lev, realspace_ba, mfi, do_costs);
         }
     }
 }
 
+SpectralFieldData&
+SpectralFieldData::operator=(SpectralFieldData&& field_data)
+{
+    if (this == &field_data) return *this;
+
+    // The plans are not managed by the members that hold them: destroy them
+    // explicitly, since they are overwritten below (e.g. when the spectral
+    // fields are remade after load balancing)
+    DestroyPlans();
+
+    fields = std::move(field_data.fields);
+    tmpSpectralField = std::move(field_data.tmpSpectralField);
+    tmpRealField = std::move(field_data.tmpRealField);
+    forward_plan = std::move(field_data.forward_plan);
+    backward_plan = std::move(field_data.backward_plan);
+    xshift_FFTfromCell = std::move(field_data.xshift_FFTfromCell);
+    xshift_FFTtoCell = std::move(field_data.xshift_FFTtoCell);
+    zshift_FFTfromCell = std::move(field_data.zshift_FFTfromCell);
+    zshift_FFTtoCell = std::move(field_data.zshift_FFTtoCell);
+#if defined(WARPX_DIM_3D)
+    yshift_FFTfromCell = std::move(field_data.yshift_FFTfromCell);
+    yshift_FFTtoCell = std::move(field_data.yshift_FFTtoCell);
+#endif
+    m_periodic_single_box = field_data.m_periodic_single_box;
+    m_distributed_fft = field_data.m_distributed_fft;
+    m_fft_domain = field_data.m_fft_domain;
+    m_fft_ba = std::move(field_data.m_fft_ba);
+    m_fft_dm = std::move(field_data.m_fft_dm);
+    m_fft_real = std::move(field_data.m_fft_real);
+    m_fft_complex = std::move(field_data.m_fft_complex);
+    m_distributed_forward_plan = std::move(field_data.m_distributed_forward_plan);
+    m_distributed_backward_plan = std::move(field_data.m_distributed_backward_plan);
+    m_distributed_copy = std::move(field_data.m_distributed_copy);
+
+    // field_data no longer owns any plan: its destructor must not destroy them
+    field_data.tmpRealField.clear();
+
+    return *this;
+}
 
 SpectralFieldData::~SpectralFieldData()
+{
+    DestroyPlans();
+}
+
+void
+SpectralFieldData::DestroyPlans ()
 {
     if (!tmpRealField.empty()){
         for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
@@ -196,6 +324,104 @@ SpectralFieldData::~SpectralFieldData()
             AnyFFT::DestroyPlan(backward_plan[mfi]);
         }
     }
+    if (m_distributed_forward_plan) AnyFFT::DestroyPlan(*m_distributed_forward_plan);
+    if (m_distributed_backward_plan) AnyFFT::DestroyPlan(*m_distributed_backward_plan);
+    m_distributed_forward_plan.reset();
+    m_distributed_backward_plan.reset();
+}
+
+void
+SpectralFieldData::GetDistributedLayout (const amrex::Box& fft_domain,
+                                         amrex::BoxArray& ba,
+                                         amrex::DistributionMapping& dm)
+{
+#if defined(WarpX_FFTW_MPI)
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    // Gather the slab of each MPI rank, as chosen by the FFT library:
+    // number of points and first index along the last axis
+    const AnyFFT::DistributedLayout layout =
+        AnyFFT::GetDistributedLayout(fft_domain.length(), AMREX_SPACEDIM, comm);
+    const long long local_slab[2] = {layout.local_n, layout.local_start};
+    amrex::Vector<long long> slabs(2*nprocs);
+    MPI_Allgather(local_slab, 2, MPI_LONG_LONG, slabs.data(), 2, MPI_LONG_LONG, comm);
+
+    constexpr int slab_dir = AMREX_SPACEDIM-1;
+    BoxList bl;
+    amrex::Vector<int> pmap;
+    for (int rank = 0; rank < nprocs; ++rank) {
+        const int n = static_cast<int>(slabs[2*rank]);
+        // The last MPI ranks may not get any data
+        if (n == 0) continue;
+        Box bx = fft_domain;
+        bx.setSmall(slab_dir, fft_domain.smallEnd(slab_dir) + static_cast<int>(slabs[2*rank+1]));
+        bx.setBig(slab_dir, bx.smallEnd(slab_dir) + n - 1);
+        bl.push_back(bx);
+        pmap.push_back(rank);
+    }
+    ba = BoxArray(std::move(bl));
+    dm = DistributionMapping(pmap);
+#else
+    amrex::ignore_unused(fft_domain, ba, dm);
+    amrex::Abort(Utils::TextMsg::Err(
+        "psatd.distributed_fft requires WarpX to be compiled with FFTW-MPI"));
+#endif
+}
+
+void
+SpectralFieldData::InitDistributedFFT (const amrex::BoxArray& realspace_ba,
+                                       const amrex::DistributionMapping& dm)
+{
+#if defined(WarpX_FFTW_MPI)
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+
+    m_fft_ba = realspace_ba;
+    m_fft_dm = dm;
+    m_fft_domain = realspace_ba.minimalBox();
+    const IntVect fft_size = m_fft_domain.length();
+
+    // Both buffers hold alloc_local complex values (the real data is padded
+    // along the first axis); MPI ranks that own no slab still take part in the FFT
+    const AnyFFT::DistributedLayout layout =
+        AnyFFT::GetDistributedLayout(fft_size, AMREX_SPACEDIM, comm);
+    const auto n_alloc = static_cast<std::size_t>(std::max<std::ptrdiff_t>(layout.alloc_local, 1));
+    m_fft_real.resize(2*n_alloc);
+    m_fft_complex.resize(n_alloc);
+
+    // Plan creation is collective over all MPI ranks
+    m_distributed_forward_plan = std::make_unique<AnyFFT::FFTplan>(
+        AnyFFT::CreateDistributedPlan(
+            fft_size, m_fft_real.data(),
+            reinterpret_cast<AnyFFT::Complex*>(m_fft_complex.data()),
+            AnyFFT::direction::R2C, AMREX_SPACEDIM, comm));
+    m_distributed_backward_plan = std::make_unique<AnyFFT::FFTplan>(
+        AnyFFT::CreateDistributedPlan(
+            fft_size, m_fft_real.data(),
+            reinterpret_cast<AnyFFT::Complex*>(m_fft_complex.data()),
+            AnyFFT::direction::C2R, AMREX_SPACEDIM, comm));
+#else
+    amrex::ignore_unused(realspace_ba, dm);
+    amrex::Abort(Utils::TextMsg::Err(
+        "psatd.distributed_fft requires WarpX to be compiled with FFTW-MPI"));
+#endif
+}
+
+amrex::MultiFab&
+SpectralFieldData::GetDistributedCopyBuffer (const amrex::IndexType& ixtype)
+{
+    for (auto& copy_mf : m_distributed_copy) {
+        if (copy_mf->ixType() == ixtype) return *copy_mf;
+    }
+    // Same indices as the cell-centered slabs: along a nodal direction, the slabs
+    // do not overlap and the last point of the domain is discarded, as for local FFTs
+    BoxList bl(ixtype);
+    for (int i = 0; i < m_fft_ba.size(); ++i) {
+        bl.push_back(Box(m_fft_ba[i].smallEnd(), m_fft_ba[i].bigEnd(), ixtype));
+    }
+    m_distributed_copy.push_back(
+        std::make_unique<MultiFab>(BoxArray(std::move(bl)), m_fft_dm, 1, 0));
+    return *m_distributed_copy.back();
 }
 
 /* \brief Transform the component `i_comp` of MultiFab `mf`
@@ -222,6 +448,65 @@ SpectralFieldData::ForwardTransform (const int lev,
     const bool is_nodal_z = mf.is_nodal(0);
 #endif
 
+    if (m_distributed_fft)
+    {
+        // Copy the real-space field `mf` to the slabs of the global FFT
+        MultiFab& slab_mf = GetDistributedCopyBuffer(mf.ixType());
+        slab_mf.ParallelCopy(mf, i_comp, 0, 1);
+        for ( MFIter mfi(slab_mf); mfi.isValid(); ++mfi ){
+            const Box slab_bx = m_fft_ba[mfi.index()];
+            const Dim3 lo = amrex::lbound(slab_bx);
+            const Dim3 hi = amrex::ubound(slab_bx);
+            Array4<const Real> slab_arr = slab_mf[mfi].const_array();
+            // Real data of the FFT library, padded along the first axis
+            Array4<Real> fft_arr(m_fft_real.data(), lo,
+                Dim3{lo.x + 2*(slab_bx.length(0)/2+1), hi.y+1, hi.z+1}, 1);
+            ParallelFor( slab_bx,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                fft_arr(i,j,k) = slab_arr(i,j,k);
+            });
+        }
+
+        // Perform the global Fourier transform (collective over all MPI ranks)
+        AnyFFT::Execute(*m_distributed_forward_plan);
+
+        // Copy the spectral-space data of the local slab to the appropriate
+        // index of the FabArray `fields`, and apply the correcting shift factor
+        for ( MFIter mfi(fields); mfi.isValid(); ++mfi ){
+            const Box spectralspace_bx = fields[mfi].box();
+            const Dim3 lo = amrex::lbound(spectralspace_bx);
+            const Dim3 hi = amrex::ubound(spectralspace_bx);
+            Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
+            Array4<const Complex> fft_arr(m_fft_complex.data(), lo,
+                Dim3{hi.x+1, hi.y+1, hi.z+1}, 1);
+#if (AMREX_SPACEDIM >= 2)
+            const Complex* xshift_arr = xshift_FFTfromCell[mfi].dataPtr();
+#endif
+#if defined(WARPX_DIM_3D)
+            const Complex* yshift_arr = yshift_FFTfromCell[mfi].dataPtr();
+#endif
+            const Complex* zshift_arr = zshift_FFTfromCell[mfi].dataPtr();
+
+            ParallelFor( spectralspace_bx,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                Complex spectral_field_value = fft_arr(i,j,k);
+#if (AMREX_SPACEDIM >= 2)
+                if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
+#endif
+#if defined(WARPX_DIM_3D)
+                if (is_nodal_y==false) spectral_field_value *= yshift_arr[j];
+                if (is_nodal_z==false) spectral_field_value *= zshift_arr[k];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
+#elif defined(WARPX_DIM_1D_Z)
+                if (is_nodal_z==false) spectral_field_value *= zshift_arr[i];
+#endif
+                fields_arr(i,j,k,field_index) = spectral_field_value;
+            });
+        }
+        return;
+    }
+
     // Loop over boxes
     // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
     //       the FFTs on each box!
@@ -230,7 +515,7 @@ SpectralFieldData::ForwardTransform (const int lev,
         {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         // Copy the real-space field `mf` to the temporary field `tmpRealField`
         // This ensures that all fields have the same number of points
@@ -297,8 +582,8 @@ SpectralFieldData::ForwardTransform (const int lev,
         if (do_costs)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
@@ -344,6 +629,68 @@ SpectralFieldData::BackwardTransform (const int lev,
     const int sk = (is_nodal_z) ? 1 : 0;
 #endif
 
+    if (m_distributed_fft)
+    {
+        // Copy the spectral field of the local slab to the buffer of the FFT library,
+        // and apply the correcting shift factor
+        for ( MFIter mfi(fields); mfi.isValid(); ++mfi ){
+            const Box spectralspace_bx = fields[mfi].box();
+            const Dim3 lo = amrex::lbound(spectralspace_bx);
+            const Dim3 hi = amrex::ubound(spectralspace_bx);
+            Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].const_array();
+            Array4<Complex> fft_arr(m_fft_complex.data(), lo,
+                Dim3{hi.x+1, hi.y+1, hi.z+1}, 1);
+#if (AMREX_SPACEDIM >= 2)
+            const Complex* xshift_arr = xshift_FFTtoCell[mfi].dataPtr();
+#endif
+#if defined(WARPX_DIM_3D)
+            const Complex* yshift_arr = yshift_FFTtoCell[mfi].dataPtr();
+#endif
+            const Complex* zshift_arr = zshift_FFTtoCell[mfi].dataPtr();
+
+            ParallelFor( spectralspace_bx,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                Complex spectral_field_value = field_arr(i,j,k,field_index);
+#if (AMREX_SPACEDIM >= 2)
+                if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
+#endif
+#if defined(WARPX_DIM_3D)
+                if (is_nodal_y==false) spectral_field_value *= yshift_arr[j];
+                if (is_nodal_z==false) spectral_field_value *= zshift_arr[k];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
+#elif defined(WARPX_DIM_1D_Z)
+                if (is_nodal_z==false) spectral_field_value *= zshift_arr[i];
+#endif
+                fft_arr(i,j,k) = spectral_field_value;
+            });
+        }
+
+        // Perform the global inverse Fourier transform (collective over all MPI ranks)
+        AnyFFT::Execute(*m_distributed_backward_plan);
+
+        // Copy the real-space data of the local slab to the slab copy and normalize
+        MultiFab& slab_mf = GetDistributedCopyBuffer(mf.ixType());
+        const amrex::Real inv_N = 1._rt / m_fft_domain.numPts();
+        for ( MFIter mfi(slab_mf); mfi.isValid(); ++mfi ){
+            const Box slab_bx = m_fft_ba[mfi.index()];
+            const Dim3 lo = amrex::lbound(slab_bx);
+            const Dim3 hi = amrex::ubound(slab_bx);
+            Array4<Real> slab_arr = slab_mf[mfi].array();
+            Array4<const Real> fft_arr(m_fft_real.data(), lo,
+                Dim3{lo.x + 2*(slab_bx.length(0)/2+1), hi.y+1, hi.z+1}, 1);
+            ParallelFor( slab_bx,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                slab_arr(i,j,k) = inv_N * fft_arr(i,j,k);
+            });
+        }
+
+        // Copy the slabs to the valid points of `mf`: along a nodal direction,
+        // the last point of the periodic domain is set equal to the first one
+        mf.ParallelCopy(slab_mf, 0, i_comp, 1, amrex::Periodicity(m_fft_domain.length()));
+        return;
+    }
+
     // Numbers of guard cells
     const amrex::IntVect& mf_ng = mf.nGrowVect();
 
@@ -355,7 +702,7 @@ SpectralFieldData::BackwardTransform (const int lev,
         {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         // Copy the spectral-space field `tmpSpectralField` to the appropriate
         // field (specified by the input argument field_index)
@@ -458,8 +805,8 @@ SpectralFieldData::BackwardTransform (const int lev,
         if (do_costs)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
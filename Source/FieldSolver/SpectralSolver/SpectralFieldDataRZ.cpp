@@ -9,8 +9,11 @@
 #include "WarpX.H"
 #include "Utils/WarpXUtil.H"
 
+#include <ablastr/utils/Communication.H>
 #include <ablastr/warn_manager/WarnManager.H>
 
+#include <utility>
+
 using amrex::operator""_rt;
 
 /* \brief Initialize fields in spectral space, and FFT plans
@@ -68,142 +71,234 @@ SpectralFieldDataRZ::SpectralFieldDataRZ (const int lev,
     // Loop over boxes and allocate the corresponding plan
     // for each box owned by the local MPI proc.
     for (amrex::MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi){
-        amrex::IntVect grid_size = realspace_ba[mfi].length();
+        InitBox(lev, realspace_ba, mfi);
+    }
+}
+
+/* \brief Create the FFT plans and the Hankel transformer of the local box mfi
+ * (the FFT plans are bound to the temporary arrays of this box) */
+void
+SpectralFieldDataRZ::InitBox (const int lev, amrex::BoxArray const & realspace_ba,
+                              amrex::MFIter const & mfi)
+{
+    amrex::IntVect grid_size = realspace_ba[mfi].length();
 #if defined(AMREX_USE_CUDA)
-        // Create cuFFT plan.
-        // This is alway complex to complex.
-        // This plan is for one azimuthal mode only.
-        cufftResult result;
-        int fft_length[] = {grid_size[1]};
-        int inembed[] = {grid_size[1]};
-        int istride = grid_size[0];
-        int idist = 1;
-        int onembed[] = {grid_size[1]};
-        int ostride = grid_size[0];
-        int odist = 1;
-        int batch = grid_size[0]; // number of ffts
+    // Create cuFFT plan.
+    // This is alway complex to complex.
+    // This plan is for one azimuthal mode only.
+    cufftResult result;
+    int fft_length[] = {grid_size[1]};
+    int inembed[] = {grid_size[1]};
+    int istride = grid_size[0];
+    int idist = 1;
+    int onembed[] = {grid_size[1]};
+    int ostride = grid_size[0];
+    int odist = 1;
+    int batch = grid_size[0]; // number of ffts
 #  ifdef AMREX_USE_FLOAT
-        auto cufft_type = CUFFT_C2C;
+    auto cufft_type = CUFFT_C2C;
 #  else
-        auto cufft_type = CUFFT_Z2Z;
+    auto cufft_type = CUFFT_Z2Z;
 #  endif
-        result = cufftPlanMany(&forward_plan[mfi], 1, fft_length, inembed, istride, idist,
-                               onembed, ostride, odist, cufft_type, batch);
-        if (result != CUFFT_SUCCESS) {
-            ablastr::warn_manager::WMRecordWarning("Spectral solver",
-                "cufftPlanMany failed!", ablastr::warn_manager::WarnPriority::high);
-        }
-        // The backward plane is the same as the forward since the direction is passed when executed.
+    result = cufftPlanMany(&forward_plan[mfi], 1, fft_length, inembed, istride, idist,
+                           onembed, ostride, odist, cufft_type, batch);
+    if (result != CUFFT_SUCCESS) {
+        ablastr::warn_manager::WMRecordWarning("Spectral solver",
+            "cufftPlanMany failed!", ablastr::warn_manager::WarnPriority::high);
+    }
+    // The backward plane is the same as the forward since the direction is passed when executed.
 #elif defined(AMREX_USE_HIP)
-        const std::size_t fft_length[] = {static_cast<std::size_t>(grid_size[1])};
-        const std::size_t stride[] = {static_cast<std::size_t>(grid_size[0])};
-        rocfft_plan_description description;
-        rocfft_status result;
-        result = rocfft_plan_description_create(&description);
-        result = rocfft_plan_description_set_data_layout(description,
-                                                         rocfft_array_type_complex_interleaved,
-                                                         rocfft_array_type_complex_interleaved,
-                                                         nullptr, nullptr,
-                                                         1, stride, 1,
-                                                         1, stride, 1);
-
-        result = rocfft_plan_create(&(forward_plan[mfi]),
-                                    rocfft_placement_notinplace,
-                                    rocfft_transform_type_complex_forward,
+    const std::size_t fft_length[] = {static_cast<std::size_t>(grid_size[1])};
+    const std::size_t stride[] = {static_cast<std::size_t>(grid_size[0])};
+    rocfft_plan_description description;
+    rocfft_status result;
+    result = rocfft_plan_description_create(&description);
+    result = rocfft_plan_description_set_data_layout(description,
+                                                     rocfft_array_type_complex_interleaved,
+                                                     rocfft_array_type_complex_interleaved,
+                                                     nullptr, nullptr,
+                                                     1, stride, 1,
+                                                     1, stride, 1);
+
+    result = rocfft_plan_create(&(forward_plan[mfi]),
+                                rocfft_placement_notinplace,
+                                rocfft_transform_type_complex_forward,
 #ifdef AMREX_USE_FLOAT
-                                    rocfft_precision_single,
+                                rocfft_precision_single,
 #else
-                                    rocfft_precision_double,
+                                rocfft_precision_double,
 #endif
-                                    1, fft_length,
-                                    grid_size[0], // number of transforms
-                                    description);
-        if (result != rocfft_status_success) {
-            ablastr::warn_manager::WMRecordWarning("Spectral solver",
-                "rocfft_plan_create failed!\n",
-                ablastr::warn_manager::WarnPriority::high);
-        }
+                                1, fft_length,
+                                grid_size[0], // number of transforms
+                                description);
+    if (result != rocfft_status_success) {
+        ablastr::warn_manager::WMRecordWarning("Spectral solver",
+            "rocfft_plan_create failed!\n",
+            ablastr::warn_manager::WarnPriority::high);
+    }
 
-        result = rocfft_plan_create(&(backward_plan[mfi]),
-                                    rocfft_placement_notinplace,
-                                    rocfft_transform_type_complex_inverse,
+    result = rocfft_plan_create(&(backward_plan[mfi]),
+                                rocfft_placement_notinplace,
+                                rocfft_transform_type_complex_inverse,
 #ifdef AMREX_USE_FLOAT
-                                    rocfft_precision_single,
+                                rocfft_precision_single,
 #else
-                                    rocfft_precision_double,
+                                rocfft_precision_double,
 #endif
-                                    1, fft_length,
-                                    grid_size[0], // number of transforms
-                                    description);
-        if (result != rocfft_status_success) {
-            ablastr::warn_manager::WMRecordWarning("Spectral solver",
-                "rocfft_plan_create failed!\n",
-                ablastr::warn_manager::WarnPriority::high);
-        }
+                                1, fft_length,
+                                grid_size[0], // number of transforms
+                                description);
+    if (result != rocfft_status_success) {
+        ablastr::warn_manager::WMRecordWarning("Spectral solver",
+            "rocfft_plan_create failed!\n",
+            ablastr::warn_manager::WarnPriority::high);
+    }
 
-        result = rocfft_plan_description_destroy(description);
-        if (result != rocfft_status_success) {
-            ablastr::warn_manager::WMRecordWarning("Spectral solver",
-                "rocfft_plan_description_destroy failed!\n",
-                ablastr::warn_manager::WarnPriority::high);
-        }
+    result = rocfft_plan_description_destroy(description);
+    if (result != rocfft_status_success) {
+        ablastr::warn_manager::WMRecordWarning("Spectral solver",
+            "rocfft_plan_description_destroy failed!\n",
+            ablastr::warn_manager::WarnPriority::high);
+    }
 #else
-        // Create FFTW plans.
-        fftw_iodim dims[1];
-        fftw_iodim howmany_dims[2];
-        dims[0].n = grid_size[1];
-        dims[0].is = grid_size[0];
-        dims[0].os = grid_size[0];
-        howmany_dims[0].n = n_rz_azimuthal_modes;
-        howmany_dims[0].is = grid_size[0]*grid_size[1];
-        howmany_dims[0].os = grid_size[0]*grid_size[1];
-        howmany_dims[1].n = grid_size[0];
-        howmany_dims[1].is = 1;
-        howmany_dims[1].os = 1;
-        forward_plan[mfi] =
-            // Note that AMReX FAB are Fortran-order.
-            fftw_plan_guru_dft(1, // int rank
-                               dims,
-                               2, // int howmany_rank,
-                               howmany_dims,
-                               reinterpret_cast<fftw_complex*>(tempHTransformed[mfi].dataPtr()), // fftw_complex *in
-                               reinterpret_cast<fftw_complex*>(tmpSpectralField[mfi].dataPtr()), // fftw_complex *out
-                               FFTW_FORWARD, // int sign
-                               FFTW_ESTIMATE); // unsigned flags
-        backward_plan[mfi] =
-            fftw_plan_guru_dft(1, // int rank
-                               dims,
-                               2, // int howmany_rank,
-                               howmany_dims,
-                               reinterpret_cast<fftw_complex*>(tmpSpectralField[mfi].dataPtr()), // fftw_complex *in
-                               reinterpret_cast<fftw_complex*>(tempHTransformed[mfi].dataPtr()), // fftw_complex *out
-                               FFTW_BACKWARD, // int sign
-                               FFTW_ESTIMATE); // unsigned flags
+    // Create FFTW plans.
+    fftw_iodim dims[1];
+    fftw_iodim howmany_dims[2];
+    dims[0].n = grid_size[1];
+    dims[0].is = grid_size[0];
+    dims[0].os = grid_size[0];
+    howmany_dims[0].n = n_rz_azimuthal_modes;
+    howmany_dims[0].is = grid_size[0]*grid_size[1];
+    howmany_dims[0].os = grid_size[0]*grid_size[1];
+    howmany_dims[1].n = grid_size[0];
+    howmany_dims[1].is = 1;
+    howmany_dims[1].os = 1;
+    forward_plan[mfi] =
+        // Note that AMReX FAB are Fortran-order.
+        fftw_plan_guru_dft(1, // int rank
+                           dims,
+                           2, // int howmany_rank,
+                           howmany_dims,
+                           reinterpret_cast<fftw_complex*>(tempHTransformed[mfi].dataPtr()), // fftw_complex *in
+                           reinterpret_cast<fftw_complex*>(tmpSpectralField[mfi].dataPtr()), // fftw_complex *out
+                           FFTW_FORWARD, // int sign
+                           FFTW_ESTIMATE); // unsigned flags
+    backward_plan[mfi] =
+        fftw_plan_guru_dft(1, // int rank
+                           dims,
+                           2, // int howmany_rank,
+                           howmany_dims,
+                           reinterpret_cast<fftw_complex*>(tmpSpectralField[mfi].dataPtr()), // fftw_complex *in
+                           reinterpret_cast<fftw_complex*>(tempHTransformed[mfi].dataPtr()), // fftw_complex *out
+                           FFTW_BACKWARD, // int sign
+                           FFTW_ESTIMATE); // unsigned flags
 #endif
 
-        // Create the Hankel transformer for each box.
-        std::array<amrex::Real,3> xmax = WarpX::UpperCorner(mfi.tilebox(), lev, 0._rt);
-        multi_spectral_hankel_transformer[mfi] = SpectralHankelTransformer(grid_size[0], n_rz_azimuthal_modes, xmax[0]);
-    }
+    // Create the Hankel transformer for each box.
+    std::array<amrex::Real,3> xmax = WarpX::UpperCorner(mfi.tilebox(), lev, 0._rt);
+    multi_spectral_hankel_transformer[mfi] = SpectralHankelTransformer(grid_size[0], n_rz_azimuthal_modes, xmax[0]);
 }
 
-
 SpectralFieldDataRZ::~SpectralFieldDataRZ()
 {
     if (fields.size() > 0){
         for (amrex::MFIter mfi(fields); mfi.isValid(); ++mfi){
+            DestroyPlans(mfi);
+        }
+    }
+}
+
+/* \brief Destroy the FFT plans of the local box mfi */
+void
+SpectralFieldDataRZ::DestroyPlans (amrex::MFIter const & mfi)
+{
 #if defined(AMREX_USE_CUDA)
-            // Destroy cuFFT plans.
-            cufftDestroy(forward_plan[mfi]);
-            // cufftDestroy(backward_plan[mfi]); // This was never allocated.
+    // Destroy cuFFT plans.
+    cufftDestroy(forward_plan[mfi]);
+    // cufftDestroy(backward_plan[mfi]); // This was never allocated.
 #elif defined(AMREX_USE_HIP)
-            rocfft_plan_destroy(forward_plan[mfi]);
-            rocfft_plan_destroy(backward_plan[mfi]);
+    rocfft_plan_destroy(forward_plan[mfi]);
+    rocfft_plan_destroy(backward_plan[mfi]);
 #else
-            // Destroy FFTW plans.
-            fftw_destroy_plan(forward_plan[mfi]);
-            fftw_destroy_plan(backward_plan[mfi]);
+    // Destroy FFTW plans.
+    fftw_destroy_plan(forward_plan[mfi]);
+    fftw_destroy_plan(backward_plan[mfi]);
 #endif
+}
+
+/* \brief Move the spectral fields to a new DistributionMapping of the same BoxArray
+ *
+ * The boxes that keep their owner keep their memory, FFT plans, Hankel transformer
+ * and filter. These are only created for the boxes that arrive on this MPI rank.
+ * The data of the spectral fields, which is recomputed at every time step, is not sent.
+ *
+ * \param realspace_ba Box array in real space, the same as in the constructor
+ * \param k_space Spectral space, defined on dm
+ * \param dm New distribution mapping
+ * */
+void
+SpectralFieldDataRZ::RemakeDistributionMapping (const int lev,
+                                                amrex::BoxArray const & realspace_ba,
+                                                SpectralKSpaceRZ const & k_space,
+                                                amrex::DistributionMapping const & dm)
+{
+    amrex::BoxArray const & spectralspace_ba = k_space.spectralspace_ba;
+    amrex::DistributionMapping const old_dm = fields.DistributionMap();
+
+    // The plans of the boxes that leave this MPI rank are destroyed
+    for (amrex::MFIter mfi(spectralspace_ba, old_dm); mfi.isValid(); ++mfi){
+        if (dm[mfi.index()] != old_dm[mfi.index()]) DestroyPlans(mfi);
+    }
+
+    // The boxes that keep their owner keep their memory, and thus their plans
+    using ablastr::utils::communication::Redistribute;
+    Redistribute(fields, dm, false);
+    Redistribute(tempHTransformed, dm, false);
+    Redistribute(tmpSpectralField, dm, false);
+
+    zshift_FFTfromCell = k_space.getSpectralShiftFactor(dm, 1,
+                                    ShiftType::TransformFromCellCentered);
+    zshift_FFTtoCell = k_space.getSpectralShiftFactor(dm, 1,
+                                    ShiftType::TransformToCellCentered);
+
+    FFTplans old_forward_plan = std::move(forward_plan);
+    FFTplans old_backward_plan = std::move(backward_plan);
+    MultiSpectralHankelTransformer old_hankel_transformer = std::move(multi_spectral_hankel_transformer);
+    BinomialFilter old_filter = std::move(binomialfilter);
+
+    forward_plan = FFTplans(spectralspace_ba, dm);
+#ifndef AMREX_USE_CUDA
+    backward_plan = FFTplans(spectralspace_ba, dm);
+#endif
+    multi_spectral_hankel_transformer = MultiSpectralHankelTransformer(spectralspace_ba, dm);
+
+    for (amrex::MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi){
+        int const i = mfi.index();
+        if (dm[i] == old_dm[i]) {
+            forward_plan[mfi] = old_forward_plan[i];
+#ifndef AMREX_USE_CUDA
+            backward_plan[mfi] = old_backward_plan[i];
+#endif
+            multi_spectral_hankel_transformer[mfi] = std::move(old_hankel_transformer[i]);
+        } else {
+            InitBox(lev, realspace_ba, mfi);
+        }
+    }
+
+    // The filter is only defined if InitFilter was called
+    if (old_filter.size() > 0) {
+        binomialfilter = BinomialFilter(spectralspace_ba, dm);
+        auto const & dx = k_space.getCellSize();
+        auto const & kz = k_space.getKzArray();
+        for (amrex::MFIter mfi(binomialfilter); mfi.isValid(); ++mfi){
+            int const i = mfi.index();
+            if (dm[i] == old_dm[i]) {
+                binomialfilter[mfi] = std::move(old_filter[i]);
+            } else {
+                binomialfilter[mfi].InitFilterArray(multi_spectral_hankel_transformer[mfi].getKrArray(),
+                                                    kz[mfi], dx, m_filter_npass_each_dir,
+                                                    m_filter_compensation);
+            }
         }
     }
 }
@@ -444,7 +539,7 @@ SpectralFieldDataRZ::ForwardTransform (const int lev,
         {
             amrex::Gpu::synchronize();
         }
-        amrex::Real wt = amrex::second();
+        amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
         // Perform the Hankel transform first.
         // tempHTransformedSplit includes the imaginary component of mode 0.
@@ -464,8 +559,8 @@ SpectralFieldDataRZ::ForwardTransform (const int lev,
         if (do_costs)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
@@ -501,7 +596,7 @@ SpectralFieldDataRZ::ForwardTransform (const int lev,
         {
             amrex::Gpu::synchronize();
         }
-        amrex::Real wt = amrex::second();
+        amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
         amrex::Box const& realspace_bx = tempHTransformed[mfi].box();
 
@@ -530,8 +625,8 @@ SpectralFieldDataRZ::ForwardTransform (const int lev,
         if (do_costs)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
@@ -563,7 +658,7 @@ SpectralFieldDataRZ::BackwardTransform (const int lev,
         {
             amrex::Gpu::synchronize();
         }
-        amrex::Real wt = amrex::second();
+        amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
         amrex::Box realspace_bx = tempHTransformed[mfi].box();
 
@@ -614,8 +709,8 @@ SpectralFieldDataRZ::BackwardTransform (const int lev,
         if (do_costs)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
@@ -648,7 +743,7 @@ SpectralFieldDataRZ::BackwardTransform (const int lev,
         {
             amrex::Gpu::synchronize();
         }
-        amrex::Real wt = amrex::second();
+        amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
         amrex::Box realspace_bx = tempHTransformed[mfi].box();
 
@@ -710,8 +805,8 @@ SpectralFieldDataRZ::BackwardTransform (const int lev,
         if (do_costs)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 
@@ -722,6 +817,8 @@ void
 SpectralFieldDataRZ::InitFilter (amrex::IntVect const & filter_npass_each_dir, bool const compensation,
                                  SpectralKSpaceRZ const & k_space)
 {
+    m_filter_npass_each_dir = filter_npass_each_dir;
+    m_filter_compensation = compensation;
     binomialfilter = BinomialFilter(multi_spectral_hankel_transformer.boxArray(),
                                     multi_spectral_hankel_transformer.DistributionMap());
 
@@ -747,7 +844,7 @@ SpectralFieldDataRZ::ApplyFilter (const int lev, int const field_index)
         {
             amrex::Gpu::synchronize();
         }
-        amrex::Real wt = amrex::second();
+        amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
         auto const & filter_r = binomialfilter[mfi].getFilterArrayR();
         auto const & filter_z = binomialfilter[mfi].getFilterArrayZ();
@@ -772,8 +869,8 @@ SpectralFieldDataRZ::ApplyFilter (const int lev, int const field_index)
         if (do_costs)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
@@ -792,7 +889,7 @@ SpectralFieldDataRZ::ApplyFilter (const int lev, int const field_index1,
         {
             amrex::Gpu::synchronize();
         }
-        amrex::Real wt = amrex::second();
+        amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
         auto const & filter_r = binomialfilter[mfi].getFilterArrayR();
         auto const & filter_z = binomialfilter[mfi].getFilterArrayZ();
@@ -821,8 +918,8 @@ SpectralFieldDataRZ::ApplyFilter (const int lev, int const field_index1,
         if (do_costs)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
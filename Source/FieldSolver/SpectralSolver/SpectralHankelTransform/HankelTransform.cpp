@@ -184,7 +184,8 @@ HankelTransform::HankelTransform (int const hankel_order,
 
 void
 HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_icomp,
-                                         amrex::FArrayBox      & G, int const G_icomp)
+                                         amrex::FArrayBox      & G, int const G_icomp,
+                                         int const ncomp)
 {
     amrex::Box const& F_box = F.box();
     amrex::Box const& G_box = G.box();
@@ -197,13 +198,19 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
     AMREX_ALWAYS_ASSERT(nz == G_box.length(1));
     AMREX_ALWAYS_ASSERT(ngr >= 0);
     AMREX_ALWAYS_ASSERT(F_box.bigEnd(0)+1 >= m_nr);
+    AMREX_ALWAYS_ASSERT(F_icomp+ncomp <= F.nComp() && G_icomp+ncomp <= G.nComp());
 
 #ifndef AMREX_USE_GPU
-    // On CPU, the blas::gemm is significantly faster
+    // On CPU, the blas::gemm is significantly faster.
+    // The components of a FArrayBox are stored one after the other, so that
+    // ncomp consecutive components form a single matrix with ncomp*nz columns
+    // and the transform matrix is streamed only once for all of them.
+    AMREX_ASSERT(F_box.numPts() == static_cast<amrex::Long>(nrF)*nz);
+    AMREX_ASSERT(G_box.numPts() == static_cast<amrex::Long>(m_nk)*nz);
 
     // Note that M is flagged to be transposed since it has dimensions (m_nr, m_nk)
     blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
-               m_nk, nz, m_nr, 1._rt,
+               m_nk, nz*ncomp, m_nr, 1._rt,
                m_M.dataPtr(), m_nk,
                F.dataPtr(F_icomp)+ngr, nrF, 0._rt,
                G.dataPtr(G_icomp), m_nk);
@@ -219,12 +226,12 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
 
     int const nr = m_nr;
 
-    amrex::ParallelFor(G_box,
-    [=] AMREX_GPU_DEVICE(int ik, int iz, int inotused) noexcept {
-        G_arr(ik,iz,G_icomp) = 0.;
+    amrex::ParallelFor(G_box, ncomp,
+    [=] AMREX_GPU_DEVICE(int ik, int iz, int inotused, int n) noexcept {
+        G_arr(ik,iz,inotused,G_icomp+n) = 0.;
         for (int ir=0 ; ir < nr ; ir++) {
             int const ii = ir + ik*nr;
-            G_arr(ik,iz,G_icomp) += M_arr[ii]*F_arr(ir,iz,F_icomp);
+            G_arr(ik,iz,inotused,G_icomp+n) += M_arr[ii]*F_arr(ir,iz,inotused,F_icomp+n);
         }
     });
 
@@ -234,7 +241,8 @@ HankelTransform::HankelForwardTransform (amrex::FArrayBox const& F, int const F_
 
 void
 HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_icomp,
-                                         amrex::FArrayBox      & F, int const F_icomp)
+                                         amrex::FArrayBox      & F, int const F_icomp,
+                                         int const ncomp)
 {
     amrex::Box const& G_box = G.box();
     amrex::Box const& F_box = F.box();
@@ -247,13 +255,19 @@ HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_
     AMREX_ALWAYS_ASSERT(nz == G_box.length(1));
     AMREX_ALWAYS_ASSERT(ngr >= 0);
     AMREX_ALWAYS_ASSERT(F_box.bigEnd(0)+1 >= m_nr);
+    AMREX_ALWAYS_ASSERT(F_icomp+ncomp <= F.nComp() && G_icomp+ncomp <= G.nComp());
 
 #ifndef AMREX_USE_GPU
-    // On CPU, the blas::gemm is significantly faster
+    // On CPU, the blas::gemm is significantly faster.
+    // The components of a FArrayBox are stored one after the other, so that
+    // ncomp consecutive components form a single matrix with ncomp*nz columns
+    // and the transform matrix is streamed only once for all of them.
+    AMREX_ASSERT(F_box.numPts() == static_cast<amrex::Long>(nrF)*nz);
+    AMREX_ASSERT(G_box.numPts() == static_cast<amrex::Long>(m_nk)*nz);
 
     // Note that m_invM is flagged to be transposed since it has dimensions (m_nk, m_nr)
     blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
-               m_nr, nz, m_nk, 1._rt,
+               m_nr, nz*ncomp, m_nk, 1._rt,
                m_invM.dataPtr(), m_nr,
                G.dataPtr(G_icomp), m_nk, 0._rt,
                F.dataPtr(F_icomp)+ngr, nrF);
@@ -269,12 +283,12 @@ HankelTransform::HankelInverseTransform (amrex::FArrayBox const& G, int const G_
 
     int const nk = m_nk;
 
-    amrex::ParallelFor(G_box,
-    [=] AMREX_GPU_DEVICE(int ir, int iz, int inotused) noexcept {
-        F_arr(ir,iz,F_icomp) = 0.;
+    amrex::ParallelFor(G_box, ncomp,
+    [=] AMREX_GPU_DEVICE(int ir, int iz, int inotused, int n) noexcept {
+        F_arr(ir,iz,inotused,F_icomp+n) = 0.;
         for (int ik=0 ; ik < nk ; ik++) {
             int const ii = ik + ir*nk;
-            F_arr(ir,iz,F_icomp) += invM_arr[ii]*G_arr(ik,iz,G_icomp);
+            F_arr(ir,iz,inotused,F_icomp+n) += invM_arr[ii]*G_arr(ik,iz,inotused,G_icomp+n);
         }
     });
 
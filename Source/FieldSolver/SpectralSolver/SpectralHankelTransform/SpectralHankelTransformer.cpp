@@ -73,9 +73,10 @@ SpectralHankelTransformer::PhysicalToSpectral_Scalar (amrex::FArrayBox const & F
             dht0[mode]->HankelForwardTransform(F_physical, icomp, G_spectral, mode_r);
             G_spectral.setVal<amrex::RunOn::Device>(0., mode_i);
         } else {
+            // The real and imaginary parts are consecutive components of F and G,
+            // and are transformed together
             int const icomp = 2*mode - 1;
-            dht0[mode]->HankelForwardTransform(F_physical, icomp  , G_spectral, mode_r);
-            dht0[mode]->HankelForwardTransform(F_physical, icomp+1, G_spectral, mode_i);
+            dht0[mode]->HankelForwardTransform(F_physical, icomp, G_spectral, mode_r, 2);
         }
     }
 }
@@ -119,10 +120,9 @@ SpectralHankelTransformer::PhysicalToSpectral_Vector (amrex::Box const & box,
 
         amrex::Gpu::streamSynchronize();
 
-        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_r, G_p_spectral, mode_r);
-        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_i, G_p_spectral, mode_i);
-        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_r, G_m_spectral, mode_r);
-        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_i, G_m_spectral, mode_i);
+        // Transform the real and imaginary parts (consecutive components) together
+        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_r, G_p_spectral, mode_r, 2);
+        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_r, G_m_spectral, mode_r, 2);
 
     }
 }
@@ -142,14 +142,14 @@ SpectralHankelTransformer::SpectralToPhysical_Scalar (amrex::FArrayBox const & G
 
     for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
         int const mode_r = 2*mode;
-        int const mode_i = 2*mode + 1;
         if (mode == 0) {
             int const icomp = 0;
             dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp);
         } else {
+            // The real and imaginary parts are consecutive components of F and G,
+            // and are transformed together
             int const icomp = 2*mode - 1;
-            dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp);
-            dht0[mode]->HankelInverseTransform(G_spectral, mode_i, F_physical, icomp+1);
+            dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp, 2);
         }
     }
 }
@@ -174,10 +174,9 @@ SpectralHankelTransformer::SpectralToPhysical_Vector (amrex::Box const & box,
 
         amrex::Gpu::streamSynchronize();
 
-        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_r, F_r_physical, mode_r);
-        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_i, F_r_physical, mode_i);
-        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_r, F_t_physical, mode_r);
-        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_i, F_t_physical, mode_i);
+        // Transform the real and imaginary parts (consecutive components) together
+        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_r, F_r_physical, mode_r, 2);
+        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_r, F_t_physical, mode_r, 2);
 
         amrex::Gpu::streamSynchronize();
 
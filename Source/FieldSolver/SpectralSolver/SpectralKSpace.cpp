@@ -11,9 +11,12 @@
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXConst.H"
 
+#include <AMReX_BaseFab.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxList.H>
+#include <AMReX_FabArray.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuComplex.H>
 #include <AMReX_GpuDevice.H>
 #include <AMReX_GpuLaunch.H>
@@ -24,6 +27,7 @@
 
 #include <array>
 #include <cmath>
+#include <utility>
 #include <vector>
 
 using namespace amrex;
@@ -34,11 +38,15 @@ using namespace amrex;
  * of the fields in real space (cell-centered ; includes guard cells)
  * \param dm Indicates which MPI proc owns which box, in realspace_ba.
  * \param realspace_dx Cell size of the grid in real space
+ * \param fft_domain Domain of the global FFT, for a distributed FFT
+ * (in which case each box of realspace_ba is a slab of this domain)
  */
 SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
                                 const DistributionMapping& dm,
-                                const RealVect realspace_dx )
-    : dx(realspace_dx)  // Store the cell size as member `dx`
+                                const RealVect realspace_dx,
+                                const Box& fft_domain )
+    : dx(realspace_dx),  // Store the cell size as member `dx`
+      m_fft_domain(fft_domain)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         realspace_ba.ixType()==IndexType::TheCellType(),
@@ -105,7 +113,15 @@ SpectralKSpace::getKComponent( const DistributionMapping& dm,
 
         // Fill the k vector
         IntVect fft_size = realspace_ba[mfi].length();
-        const Real dk = 2*MathConst::pi/(fft_size[i_dim]*dx[i_dim]);
+        // For a distributed FFT, the box only holds a slab of the global FFT:
+        // the k values depend on the global size and on the position of the slab
+        int offset = 0;
+        if (m_fft_domain.ok()) {
+            fft_size = m_fft_domain.length();
+            offset = realspace_ba[mfi].smallEnd(i_dim) - m_fft_domain.smallEnd(i_dim);
+        }
+        const int N_fft = fft_size[i_dim];
+        const Real dk = 2*MathConst::pi/(N_fft*dx[i_dim]);
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.smallEnd(i_dim) == 0,
             "Expected box to start at 0, in spectral space.");
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.bigEnd(i_dim) == N-1,
@@ -115,20 +131,21 @@ SpectralKSpace::getKComponent( const DistributionMapping& dm,
             // (typically: first axis, in a real-to-complex FFT)
             amrex::ParallelFor(N, [=] AMREX_GPU_DEVICE (int i) noexcept
             {
-                pk[i] = i*dk;
+                pk[i] = (i+offset)*dk;
             });
         } else {
-            const int mid_point = (N+1)/2;
+            const int mid_point = (N_fft+1)/2;
             amrex::ParallelFor(N, [=] AMREX_GPU_DEVICE (int i) noexcept
             {
-                if (i < mid_point) {
+                const int ig = i + offset;
+                if (ig < mid_point) {
                     // Fill positive values of k
                     // (FFT conventions: first half is positive)
-                    pk[i] = i*dk;
+                    pk[i] = ig*dk;
                 } else {
                     // Fill negative values of k
                     // (FFT conventions: second half is negative)
-                    pk[i] = (i-N)*dk;
+                    pk[i] = (ig-N_fft)*dk;
                 }
             });
         }
@@ -278,3 +295,66 @@ SpectralKSpace::getModifiedKComponent( const DistributionMapping& dm,
     }
     return modified_k_comp;
 }
+
+void
+RedistributeKVector (KVectorComponent& k_vec, const int i_dim,
+                     const amrex::DistributionMapping& dm)
+{
+    const BoxArray& spectralspace_ba = k_vec.boxArray();
+    const DistributionMapping old_dm = k_vec.DistributionMap();
+
+    // Lay out the 1D k vectors of the boxes that change owner one after the other
+    // along x, so that they can be moved with the same one-to-one copy as the fields
+    BoxList bl;
+    Vector<int> moved_index(spectralspace_ba.size(), -1);
+    Vector<int> old_pmap, new_pmap;
+    int offset = 0;
+    for (int i = 0; i < spectralspace_ba.size(); ++i) {
+        if (old_dm[i] == dm[i]) continue;
+        moved_index[i] = static_cast<int>(old_pmap.size());
+        old_pmap.push_back(old_dm[i]);
+        new_pmap.push_back(dm[i]);
+        const int n = spectralspace_ba[i].length(i_dim);
+        Box bx(IntVect(0), IntVect(0));
+        bx.setSmall(0, offset);
+        bx.setBig(0, offset + n - 1);
+        bl.push_back(bx);
+        offset += n;
+    }
+
+    KVectorComponent k_vec_new(spectralspace_ba, dm);
+
+    if (!old_pmap.empty()) {
+        const BoxArray k_ba(std::move(bl));
+
+        FabArray<BaseFab<Real>> k_old(k_ba, DistributionMapping(std::move(old_pmap)), 1, 0);
+        for (MFIter mfi(spectralspace_ba, old_dm); mfi.isValid(); ++mfi) {
+            const int im = moved_index[mfi.index()];
+            if (im < 0) continue;
+            Gpu::copyAsync(Gpu::deviceToDevice, k_vec[mfi].begin(), k_vec[mfi].end(),
+                           k_old[im].dataPtr());
+        }
+
+        FabArray<BaseFab<Real>> k_new(k_ba, DistributionMapping(std::move(new_pmap)), 1, 0);
+        k_new.Redistribute(k_old, 0, 0, 1, IntVect(0));
+
+        for (MFIter mfi(k_vec_new); mfi.isValid(); ++mfi) {
+            const int im = moved_index[mfi.index()];
+            if (im < 0) continue;
+            const Real* k_ptr = k_new[im].dataPtr();
+            k_vec_new[mfi].resize(k_new[im].box().numPts());
+            Gpu::copyAsync(Gpu::deviceToDevice, k_ptr, k_ptr + k_new[im].box().numPts(),
+                           k_vec_new[mfi].begin());
+        }
+        Gpu::streamSynchronize();
+    }
+
+    // The boxes that keep their owner keep their k vector
+    for (MFIter mfi(k_vec_new); mfi.isValid(); ++mfi) {
+        if (moved_index[mfi.index()] < 0) {
+            k_vec_new[mfi] = std::move(k_vec[mfi.index()]);
+        }
+    }
+
+    k_vec = std::move(k_vec_new);
+}
@@ -29,20 +29,33 @@ SpectralSolver::SpectralSolver(
                 const amrex::Vector<amrex::Real>& v_comoving,
                 const amrex::RealVect dx, const amrex::Real dt,
                 const bool pml, const bool periodic_single_box,
+                const bool distributed_fft,
                 const bool update_with_rho,
+                const bool current_correction,
                 const bool fft_do_time_averaging,
                 const bool do_multi_J,
                 const bool dive_cleaning,
-                const bool divb_cleaning)
+                const bool divb_cleaning,
+                const bool on_the_fly_coefficients)
 {
     // Initialize all structures using the same distribution mapping dm
 
+    // For a distributed FFT, all structures are defined on the slabs of the
+    // global FFT instead of the boxes of the real-space fields
+    amrex::BoxArray fft_ba = realspace_ba;
+    amrex::DistributionMapping fft_dm = dm;
+    amrex::Box fft_domain;
+    if (distributed_fft) {
+        fft_domain = realspace_ba.minimalBox();
+        SpectralFieldData::GetDistributedLayout(fft_domain, fft_ba, fft_dm);
+    }
+
     // - Initialize k space object (Contains info about the size of
     // the spectral space corresponding to each box in `realspace_ba`,
     // as well as the value of the corresponding k coordinates)
-    const SpectralKSpace k_space= SpectralKSpace(realspace_ba, dm, dx);
+    const SpectralKSpace k_space= SpectralKSpace(fft_ba, fft_dm, dx, fft_domain);
 
-    m_spectral_index = SpectralFieldIndex(update_with_rho, fft_do_time_averaging,
+    m_spectral_index = SpectralFieldIndex(update_with_rho, current_correction, fft_do_time_averaging,
                                           do_multi_J, dive_cleaning, divb_cleaning, pml);
 
     // - Select the algorithm depending on the input parameters
@@ -51,7 +64,7 @@ SpectralSolver::SpectralSolver(
     if (pml) // PSATD equations in the PML grids
     {
         algorithm = std::make_unique<PsatdAlgorithmPml>(
-            k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
+            k_space, fft_dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
             fill_guards, dt, dive_cleaning, divb_cleaning);
     }
     else // PSATD equations in the regulard grids
@@ -60,7 +73,7 @@ SpectralSolver::SpectralSolver(
         if (v_comoving[0] != 0. || v_comoving[1] != 0. || v_comoving[2] != 0.)
         {
             algorithm = std::make_unique<PsatdAlgorithmComoving>(
-                k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
+                k_space, fft_dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
                 fill_guards, v_comoving, dt, update_with_rho);
         }
         else // PSATD algorithms: standard, Galilean, averaged Galilean, multi-J
@@ -68,24 +81,28 @@ SpectralSolver::SpectralSolver(
             if (do_multi_J)
             {
                 algorithm = std::make_unique<PsatdAlgorithmJLinearInTime>(
-                    k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
+                    k_space, fft_dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
                     fill_guards, dt, fft_do_time_averaging, dive_cleaning, divb_cleaning);
             }
             else // standard, Galilean, averaged Galilean
             {
                 algorithm = std::make_unique<PsatdAlgorithm>(
-                    k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
+                    k_space, fft_dm, m_spectral_index, norder_x, norder_y, norder_z, nodal,
                     fill_guards, v_galilean, dt, update_with_rho, fft_do_time_averaging,
-                    dive_cleaning, divb_cleaning);
+                    dive_cleaning, divb_cleaning, on_the_fly_coefficients);
             }
         }
     }
 
     // - Initialize arrays for fields in spectral space + FFT plans
-    field_data = SpectralFieldData(lev, realspace_ba, k_space, dm,
-                                   m_spectral_index.n_fields, periodic_single_box);
+    field_data = SpectralFieldData(lev, fft_ba, k_space, fft_dm,
+                                   m_spectral_index.n_fields, periodic_single_box,
+                                   distributed_fft);
 
     m_fill_guards = fill_guards;
+    m_dx = dx;
+    m_periodic_single_box = periodic_single_box;
+    m_distributed_fft = distributed_fft;
 }
 
 void
@@ -117,4 +134,24 @@ SpectralSolver::pushSpectralFields(){
     algorithm->pushSpectralFields( field_data );
 }
 
+void
+SpectralSolver::RemakeDistributionMapping (const int lev,
+                                           const amrex::BoxArray& realspace_ba,
+                                           const amrex::DistributionMapping& dm)
+{
+    WARPX_PROFILE("SpectralSolver::RemakeDistributionMapping");
+
+    // With a distributed FFT, all spectral structures are defined on the
+    // slabs of the global FFT, which do not depend on dm
+    if (m_distributed_fft) return;
+
+    algorithm->RemakeDistributionMapping(dm);
+
+    // The FFT plans are bound to the memory of the local boxes and cannot be
+    // sent to another rank: they are only created for the boxes that arrive
+    // on this rank. The k space itself only holds 1D vectors, cheap to recompute.
+    const SpectralKSpace k_space = SpectralKSpace(realspace_ba, dm, m_dx);
+    field_data.RemakeDistributionMapping(lev, realspace_ba, k_space, dm);
+}
+
 #endif // WARPX_USE_PSATD
@@ -34,6 +34,7 @@ SpectralSolverRZ::SpectralSolverRZ (const int lev,
                                     amrex::RealVect const dx, amrex::Real const dt,
                                     bool const with_pml,
                                     bool const update_with_rho,
+                                    const bool current_correction,
                                     const bool fft_do_time_averaging,
                                     const bool do_multi_J,
                                     const bool dive_cleaning,
@@ -47,7 +48,7 @@ SpectralSolverRZ::SpectralSolverRZ (const int lev,
     //   as well as the value of the corresponding k coordinates.
 
     const bool is_pml = false;
-    m_spectral_index = SpectralFieldIndex(update_with_rho, fft_do_time_averaging,
+    m_spectral_index = SpectralFieldIndex(update_with_rho, current_correction, fft_do_time_averaging,
                                           do_multi_J, dive_cleaning, divb_cleaning, is_pml, with_pml);
 
     // - Select the algorithm depending on the input parameters
@@ -161,3 +162,19 @@ SpectralSolverRZ::VayDeposition ()
 {
     algorithm->VayDeposition(field_data);
 }
+
+void
+SpectralSolverRZ::RemakeDistributionMapping (const int lev,
+                                             amrex::BoxArray const & realspace_ba,
+                                             amrex::DistributionMapping const & dm)
+{
+    WARPX_PROFILE("SpectralSolverRZ::RemakeDistributionMapping");
+
+    algorithm->RemakeDistributionMapping(dm);
+    if (PML_algorithm) PML_algorithm->RemakeDistributionMapping(dm);
+
+    // The k space only holds 1D vectors, cheap to recompute
+    amrex::RealVect const dx = k_space.getCellSize();
+    k_space = SpectralKSpaceRZ(realspace_ba, dm, dx);
+    field_data.RemakeDistributionMapping(lev, realspace_ba, k_space, dm);
+}
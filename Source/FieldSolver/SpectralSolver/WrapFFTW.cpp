@@ -14,6 +14,9 @@
 #include <AMReX_REAL.H>
 
 #include <fftw3.h>
+#ifdef WarpX_FFTW_MPI
+#   include <fftw3-mpi.h>
+#endif
 
 namespace AnyFFT
 {
@@ -22,11 +25,29 @@ namespace AnyFFT
     const auto VendorCreatePlanC2R3D = fftwf_plan_dft_c2r_3d;
     const auto VendorCreatePlanR2C2D = fftwf_plan_dft_r2c_2d;
     const auto VendorCreatePlanC2R2D = fftwf_plan_dft_c2r_2d;
+#   ifdef WarpX_FFTW_MPI
+    const auto VendorMPIInit = fftwf_mpi_init;
+    const auto VendorMPILocalSize3D = fftwf_mpi_local_size_3d;
+    const auto VendorMPILocalSize2D = fftwf_mpi_local_size_2d;
+    const auto VendorMPICreatePlanR2C3D = fftwf_mpi_plan_dft_r2c_3d;
+    const auto VendorMPICreatePlanC2R3D = fftwf_mpi_plan_dft_c2r_3d;
+    const auto VendorMPICreatePlanR2C2D = fftwf_mpi_plan_dft_r2c_2d;
+    const auto VendorMPICreatePlanC2R2D = fftwf_mpi_plan_dft_c2r_2d;
+#   endif
 #else
     const auto VendorCreatePlanR2C3D = fftw_plan_dft_r2c_3d;
     const auto VendorCreatePlanC2R3D = fftw_plan_dft_c2r_3d;
     const auto VendorCreatePlanR2C2D = fftw_plan_dft_r2c_2d;
     const auto VendorCreatePlanC2R2D = fftw_plan_dft_c2r_2d;
+#   ifdef WarpX_FFTW_MPI
+    const auto VendorMPIInit = fftw_mpi_init;
+    const auto VendorMPILocalSize3D = fftw_mpi_local_size_3d;
+    const auto VendorMPILocalSize2D = fftw_mpi_local_size_2d;
+    const auto VendorMPICreatePlanR2C3D = fftw_mpi_plan_dft_r2c_3d;
+    const auto VendorMPICreatePlanC2R3D = fftw_mpi_plan_dft_c2r_3d;
+    const auto VendorMPICreatePlanR2C2D = fftw_mpi_plan_dft_r2c_2d;
+    const auto VendorMPICreatePlanC2R2D = fftw_mpi_plan_dft_c2r_2d;
+#   endif
 #endif
 
     FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
@@ -95,4 +116,95 @@ namespace AnyFFT
         fftw_execute( fft_plan.m_plan );
 #  endif
     }
+
+#ifdef WarpX_FFTW_MPI
+    /** Initialize the threads of FFTW (if used) and then FFTW-MPI, as required by FFTW:
+     *  this is called before any other FFTW-MPI routine (subsequent calls do nothing) */
+    static void InitDistributedFFTW ()
+    {
+#if defined(AMREX_USE_OMP) && defined(WarpX_FFTW_OMP)
+#   ifdef AMREX_USE_FLOAT
+        fftwf_init_threads();
+        fftwf_plan_with_nthreads(omp_get_max_threads());
+#   else
+        fftw_init_threads();
+        fftw_plan_with_nthreads(omp_get_max_threads());
+#   endif
+#endif
+        VendorMPIInit();
+    }
+
+    DistributedLayout GetDistributedLayout(const amrex::IntVect& real_size, const int dim,
+                                           MPI_Comm comm)
+    {
+        // Must be called before any other FFTW-MPI routine
+        InitDistributedFFTW();
+
+        DistributedLayout layout;
+
+        // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order.
+        // The complex array only holds the positive k values along the fastest axis.
+        if (dim == 3) {
+            layout.alloc_local = VendorMPILocalSize3D(
+                real_size[2], real_size[1], real_size[0]/2+1, comm,
+                &layout.local_n, &layout.local_start);
+        } else if (dim == 2) {
+            layout.alloc_local = VendorMPILocalSize2D(
+                real_size[1], real_size[0]/2+1, comm,
+                &layout.local_n, &layout.local_start);
+        } else {
+            amrex::Abort(Utils::TextMsg::Err(
+                "only dim=2 and dim=3 have been implemented for distributed FFTs"));
+        }
+
+        return layout;
+    }
+
+    FFTplan CreateDistributedPlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
+                                  Complex * const complex_array, const direction dir,
+                                  const int dim, MPI_Comm comm)
+    {
+        FFTplan fft_plan;
+
+        InitDistributedFFTW();
+
+        // Initialize fft_plan.m_plan with the vendor fft plan.
+        // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
+        if (dir == direction::R2C){
+            if (dim == 3) {
+                fft_plan.m_plan = VendorMPICreatePlanR2C3D(
+                    real_size[2], real_size[1], real_size[0], real_array, complex_array,
+                    comm, FFTW_ESTIMATE);
+            } else if (dim == 2) {
+                fft_plan.m_plan = VendorMPICreatePlanR2C2D(
+                    real_size[1], real_size[0], real_array, complex_array,
+                    comm, FFTW_ESTIMATE);
+            } else {
+                amrex::Abort(Utils::TextMsg::Err(
+                    "only dim=2 and dim=3 have been implemented for distributed FFTs"));
+            }
+        } else if (dir == direction::C2R){
+            if (dim == 3) {
+                fft_plan.m_plan = VendorMPICreatePlanC2R3D(
+                    real_size[2], real_size[1], real_size[0], complex_array, real_array,
+                    comm, FFTW_ESTIMATE);
+            } else if (dim == 2) {
+                fft_plan.m_plan = VendorMPICreatePlanC2R2D(
+                    real_size[1], real_size[0], complex_array, real_array,
+                    comm, FFTW_ESTIMATE);
+            } else {
+                amrex::Abort(Utils::TextMsg::Err(
+                    "only dim=2 and dim=3 have been implemented for distributed FFTs"));
+            }
+        }
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = real_array;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = dim;
+
+        return fft_plan;
+    }
+#endif
 }
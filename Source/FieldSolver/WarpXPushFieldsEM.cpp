@@ -788,6 +788,15 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 #endif
 }
 
+void
+WarpX::EvolveEBFused (amrex::Real a_dt)
+{
+    WARPX_PROFILE("WarpX::EvolveEBFused()");
+    // Level 0 only, with periodic boundaries (checked in ReadParameters):
+    // there is no PML and no boundary condition to apply in between the half steps
+    m_fdtd_solver_fp[0]->EvolveEBFused(Efield_fp[0], Bfield_fp[0], current_fp[0], 0, a_dt);
+}
+
 
 void
 WarpX::EvolveF (amrex::Real a_dt, DtType a_dt_type)
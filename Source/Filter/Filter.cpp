@@ -9,6 +9,7 @@
 
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXUtil.H"
 
 #include <AMReX_Array4.H>
 #include <AMReX_Box.H>
@@ -23,6 +24,23 @@
 
 using namespace amrex;
 
+MultiFab&
+Filter::GetScratch (const MultiFab& mf, int ncomp, const IntVect& ng, int slot)
+{
+    for (auto& [scratch_slot, scratch] : m_scratch) {
+        if (scratch_slot == slot &&
+            scratch->nComp() == ncomp &&
+            scratch->nGrowVect() == ng &&
+            scratch->boxArray() == mf.boxArray() &&
+            scratch->DistributionMap() == mf.DistributionMap()) {
+            return *scratch;
+        }
+    }
+    m_scratch.emplace_back(slot,
+        std::make_unique<MultiFab>(mf.boxArray(), mf.DistributionMap(), ncomp, ng));
+    return *m_scratch.back().second;
+}
+
 #ifdef AMREX_USE_GPU
 
 /* \brief Apply stencil on MultiFab (GPU version, 2D/3D).
@@ -47,7 +65,7 @@ Filter::ApplyStencil (MultiFab& dstmf, const MultiFab& srcmf, const int lev, int
         {
             amrex::Gpu::synchronize();
         }
-        amrex::Real wt = amrex::second();
+        amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
         const auto& src = srcmf.array(mfi);
         const auto& dst = dstmf.array(mfi);
@@ -59,8 +77,8 @@ Filter::ApplyStencil (MultiFab& dstmf, const MultiFab& srcmf, const int lev, int
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
             amrex::Gpu::synchronize();
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
         }
     }
 }
@@ -218,26 +236,32 @@ Filter::ApplyStencil (amrex::MultiFab& dstmf, const amrex::MultiFab& srcmf, cons
             {
                 amrex::Gpu::synchronize();
             }
-            amrex::Real wt = amrex::second();
+            amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
             const auto& srcfab = srcmf[mfi];
             auto& dstfab = dstmf[mfi];
             const Box& tbx = mfi.growntilebox();
             const Box& gbx = amrex::grow(tbx,stencil_length_each_dir-1);
-            // tmpfab has enough ghost cells for the stencil
-            tmpfab.resize(gbx,ncomp);
-            tmpfab.setVal(0.0, gbx, 0, ncomp);
-            // Copy values in srcfab into tmpfab
-            const Box& ibx = gbx & srcfab.box();
-            tmpfab.copy(srcfab, ibx, scomp, ibx, 0, ncomp);
-            // Apply filter
-            DoFilter(tbx, tmpfab.array(), dstfab.array(), 0, dcomp, ncomp);
+            if (srcfab.box().contains(gbx)) {
+                // The stencil only reads data of srcfab: filter it in place
+                DoFilter(tbx, srcfab.const_array(), dstfab.array(), scomp, dcomp, ncomp);
+            } else {
+                // tmpfab has enough ghost cells for the stencil,
+                // and is padded with zeros beyond the data of srcfab
+                tmpfab.resize(gbx,ncomp);
+                tmpfab.setVal(0.0, gbx, 0, ncomp);
+                // Copy values in srcfab into tmpfab
+                const Box& ibx = gbx & srcfab.box();
+                tmpfab.copy(srcfab, ibx, scomp, ibx, 0, ncomp);
+                // Apply filter
+                DoFilter(tbx, tmpfab.array(), dstfab.array(), 0, dcomp, ncomp);
+            }
 
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
-                wt = amrex::second() - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+                wt = WarpXUtilLoadBalance::CostClock() - wt;
+                WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::FieldSolve, wt);
             }
         }
     }
@@ -488,7 +488,8 @@ WarpX::InitPML ()
             do_pml_Hi[0][idim] = 1; // on level 0
         }
     }
-    if (finest_level > 0) do_pml = 1;
+    // Refinement patches are surrounded by PML, including those created by regridding
+    if (finest_level > 0 || (max_level > 0 && regrid_int > 0)) do_pml = 1;
     if (do_pml)
     {
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_PSATD)
@@ -508,36 +509,42 @@ WarpX::InitPML ()
 
         for (int lev = 1; lev <= finest_level; ++lev)
         {
-            do_pml_Lo[lev] = amrex::IntVect::TheUnitVector();
-            do_pml_Hi[lev] = amrex::IntVect::TheUnitVector();
-            // check if fine patch edges co-incide with domain boundary
-            amrex::Box levelBox = boxArray(lev).minimalBox();
-            // Domain box at level, lev
-            amrex::Box DomainBox = Geom(lev).Domain();
-            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-                if (levelBox.smallEnd(idim) == DomainBox.smallEnd(idim))
-                    do_pml_Lo[lev][idim] = do_pml_Lo[0][idim];
-                if (levelBox.bigEnd(idim) == DomainBox.bigEnd(idim))
-                    do_pml_Hi[lev][idim] = do_pml_Hi[0][idim];
-            }
+            InitPMLPatch(lev);
+        }
+    }
+}
+
+void
+WarpX::InitPMLPatch (int lev)
+{
+    do_pml_Lo[lev] = amrex::IntVect::TheUnitVector();
+    do_pml_Hi[lev] = amrex::IntVect::TheUnitVector();
+    // check if fine patch edges co-incide with domain boundary
+    amrex::Box levelBox = boxArray(lev).minimalBox();
+    // Domain box at level, lev
+    amrex::Box DomainBox = Geom(lev).Domain();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (levelBox.smallEnd(idim) == DomainBox.smallEnd(idim))
+            do_pml_Lo[lev][idim] = do_pml_Lo[0][idim];
+        if (levelBox.bigEnd(idim) == DomainBox.bigEnd(idim))
+            do_pml_Hi[lev][idim] = do_pml_Hi[0][idim];
+    }
 
 #ifdef WARPX_DIM_RZ
-            //In cylindrical geometry, if the edge of the patch is at r=0, do not add PML
-            if ((max_level > 0) && (fine_tag_lo[0]==0.)) {
-                do_pml_Lo[lev][0] = 0;
-            }
-#endif
-            pml[lev] = std::make_unique<PML>(lev, boxArray(lev), DistributionMap(lev),
-                                   &Geom(lev), &Geom(lev-1),
-                                   pml_ncell, pml_delta, refRatio(lev-1),
-                                   dt[lev], nox_fft, noy_fft, noz_fft, do_nodal,
-                                   do_moving_window, pml_has_particles, do_pml_in_domain,
-                                   do_multi_J, do_pml_dive_cleaning, do_pml_divb_cleaning,
-                                   guard_cells.ng_FieldSolver.max(),
-                                   v_particle_pml,
-                                   do_pml_Lo[lev], do_pml_Hi[lev]);
-        }
+    //In cylindrical geometry, if the edge of the patch is at r=0, do not add PML
+    if (levelBox.smallEnd(0) == DomainBox.smallEnd(0)) {
+        do_pml_Lo[lev][0] = 0;
     }
+#endif
+    pml[lev] = std::make_unique<PML>(lev, boxArray(lev), DistributionMap(lev),
+                           &Geom(lev), &Geom(lev-1),
+                           pml_ncell, pml_delta, refRatio(lev-1),
+                           dt[lev], nox_fft, noy_fft, noz_fft, do_nodal,
+                           do_moving_window, pml_has_particles, do_pml_in_domain,
+                           do_multi_J, do_pml_dive_cleaning, do_pml_divb_cleaning,
+                           guard_cells.ng_FieldSolver.max(),
+                           v_particle_pml,
+                           do_pml_Lo[lev], do_pml_Hi[lev]);
 }
 
 void
@@ -1212,6 +1219,8 @@ void WarpX::InitializeEBGridData (int lev)
             ScaleEdges(m_edge_lengths[lev], CellSize(lev));
             ComputeFaceAreas(m_face_areas[lev], eb_fact);
             ScaleAreas(m_face_areas[lev], CellSize(lev));
+            // Classify the tiles into regular, covered and cut tiles for the field pushes
+            m_fdtd_solver_fp[lev]->ClassifyEBTiles(m_edge_lengths[lev], m_face_areas[lev]);
 
             if (WarpX::maxwell_solver_id == MaxwellSolverAlgo::ECT) {
                 MarkCells();
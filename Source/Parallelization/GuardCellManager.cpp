@@ -47,6 +47,7 @@ guardCellManager::Init (
     const amrex::Vector<amrex::Real> v_galilean,
     const amrex::Vector<amrex::Real> v_comoving,
     const bool safe_guard_cells,
+    const bool fused_fdtd_update,
     const int do_electrostatic,
     const int do_multi_J,
     const bool fft_do_time_averaging,
@@ -268,6 +269,12 @@ guardCellManager::Init (
     }
 #endif
 
+    // The fused update computes B^{n+1/2} and E^{n+1} redundantly in the guard cells,
+    // over 2 and 1 stencil widths, so that E and B are needed in 3 stencil widths
+    if (fused_fdtd_update) {
+        ng_FieldSolver = 3*ng_FieldSolver;
+    }
+
     // Number of guard cells is the max of that determined by particle shape factor and
     // the stencil used in the field solve
     ng_alloc_EB.max( ng_FieldSolver );
@@ -984,7 +984,7 @@ void WarpX::ApplyFilterandSumBoundaryJ (
             ng += bilinear_filter.stencil_length_each_dir-1;
             ng_depos_J += bilinear_filter.stencil_length_each_dir-1;
             ng_depos_J.min(ng);
-            MultiFab jf(j[idim]->boxArray(), j[idim]->DistributionMap(), j[idim]->nComp(), ng);
+            MultiFab& jf = bilinear_filter.GetScratch(*j[idim], j[idim]->nComp(), ng);
             bilinear_filter.ApplyStencil(jf, *j[idim], lev);
             WarpXSumGuardCells(*(j[idim]), jf, period, ng_depos_J, 0, (j[idim])->nComp());
         } else {
@@ -1042,13 +1042,12 @@ void WarpX::AddCurrentFromFineLevelandSumBoundary (
                 ng += bilinear_filter.stencil_length_each_dir-1;
                 ng_depos_J += bilinear_filter.stencil_length_each_dir-1;
                 ng_depos_J.min(ng);
-                MultiFab jfc(J_cp[lev+1][idim]->boxArray(),
-                             J_cp[lev+1][idim]->DistributionMap(), J_cp[lev+1][idim]->nComp(), ng);
+                MultiFab& jfc = bilinear_filter.GetScratch(*J_cp[lev+1][idim], J_cp[lev+1][idim]->nComp(), ng);
                 bilinear_filter.ApplyStencil(jfc, *J_cp[lev+1][idim], lev+1);
 
-                // buffer patch of fine level
-                MultiFab jfb(current_buf[lev+1][idim]->boxArray(),
-                             current_buf[lev+1][idim]->DistributionMap(), current_buf[lev+1][idim]->nComp(), ng);
+                // buffer patch of fine level (jfc is still in use: use a different scratch slot)
+                MultiFab& jfb = bilinear_filter.GetScratch(*current_buf[lev+1][idim],
+                                                           current_buf[lev+1][idim]->nComp(), ng, 1);
                 bilinear_filter.ApplyStencil(jfb, *current_buf[lev+1][idim], lev+1);
 
                 MultiFab::Add(jfb, jfc, 0, 0, current_buf[lev+1][idim]->nComp(), ng);
@@ -1063,8 +1062,7 @@ void WarpX::AddCurrentFromFineLevelandSumBoundary (
                 ng += bilinear_filter.stencil_length_each_dir-1;
                 ng_depos_J += bilinear_filter.stencil_length_each_dir-1;
                 ng_depos_J.min(ng);
-                MultiFab jf(J_cp[lev+1][idim]->boxArray(),
-                            J_cp[lev+1][idim]->DistributionMap(), J_cp[lev+1][idim]->nComp(), ng);
+                MultiFab& jf = bilinear_filter.GetScratch(*J_cp[lev+1][idim], J_cp[lev+1][idim]->nComp(), ng);
                 bilinear_filter.ApplyStencil(jf, *J_cp[lev+1][idim], lev+1);
 
                 ablastr::utils::communication::ParallelAdd(mf, jf, 0, 0, J_cp[lev + 1][idim]->nComp(), ng,
@@ -1135,7 +1133,7 @@ void WarpX::ApplyFilterandSumBoundaryRho (int /*lev*/, int glev, amrex::MultiFab
         ng += bilinear_filter.stencil_length_each_dir-1;
         ng_depos_rho += bilinear_filter.stencil_length_each_dir-1;
         ng_depos_rho.min(ng);
-        MultiFab rf(rho.boxArray(), rho.DistributionMap(), ncomp, ng);
+        MultiFab& rf = bilinear_filter.GetScratch(rho, ncomp, ng);
         bilinear_filter.ApplyStencil(rf, rho, glev, icomp, 0, ncomp);
         WarpXSumGuardCells(rho, rf, period, ng_depos_rho, icomp, ncomp );
     } else {
@@ -1183,13 +1181,11 @@ void WarpX::AddRhoFromFineLevelandSumBoundary (
             ng += bilinear_filter.stencil_length_each_dir-1;
             ng_depos_rho += bilinear_filter.stencil_length_each_dir-1;
             ng_depos_rho.min(ng);
-            MultiFab rhofc(charge_cp[lev+1]->boxArray(),
-                           charge_cp[lev+1]->DistributionMap(), ncomp, ng);
+            MultiFab& rhofc = bilinear_filter.GetScratch(*charge_cp[lev+1], ncomp, ng);
             bilinear_filter.ApplyStencil(rhofc, *charge_cp[lev+1], lev+1, icomp, 0, ncomp);
 
-            // buffer patch of fine level
-            MultiFab rhofb(charge_buf[lev+1]->boxArray(),
-                           charge_buf[lev+1]->DistributionMap(), ncomp, ng);
+            // buffer patch of fine level (rhofc is still in use: use a different scratch slot)
+            MultiFab& rhofb = bilinear_filter.GetScratch(*charge_buf[lev+1], ncomp, ng, 1);
             bilinear_filter.ApplyStencil(rhofb, *charge_buf[lev+1], lev+1, icomp, 0, ncomp);
 
             MultiFab::Add(rhofb, rhofc, 0, 0, ncomp, ng);
@@ -1203,7 +1199,7 @@ void WarpX::AddRhoFromFineLevelandSumBoundary (
             ng += bilinear_filter.stencil_length_each_dir-1;
             ng_depos_rho += bilinear_filter.stencil_length_each_dir-1;
             ng_depos_rho.min(ng);
-            MultiFab rf(charge_cp[lev+1]->boxArray(), charge_cp[lev+1]->DistributionMap(), ncomp, ng);
+            MultiFab& rf = bilinear_filter.GetScratch(*charge_cp[lev+1], ncomp, ng);
             bilinear_filter.ApplyStencil(rf, *charge_cp[lev+1], lev+1, icomp, 0, ncomp);
 
             ablastr::utils::communication::ParallelAdd(mf, rf, 0, 0, ncomp, ng, IntVect::TheZeroVector(),
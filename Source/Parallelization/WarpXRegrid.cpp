@@ -8,22 +8,41 @@
  */
 #include "WarpX.H"
 
+#include "BoundaryConditions/PML.H"
+#if (defined WARPX_DIM_RZ) && (defined WARPX_USE_PSATD)
+#   include "BoundaryConditions/PML_RZ.H"
+#endif
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "EmbeddedBoundary/WarpXFaceInfoBox.H"
+#include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceSolver.H"
+#include "FieldSolver/FiniteDifferenceSolver/MacroscopicProperties/MacroscopicProperties.H"
+#ifdef WARPX_USE_PSATD
+#   ifndef WARPX_DIM_RZ
+#       include "FieldSolver/SpectralSolver/SpectralSolver.H"
+#   endif
+#endif
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/Interpolate.H"
+#include "Utils/Interpolate_K.H"
+#include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
+#include <ablastr/utils/Communication.H>
+
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FabFactory.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_IArrayBox.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_LayoutData.H>
@@ -33,6 +52,8 @@
 #include <AMReX_ParIter.H>
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Print.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 #include <AMReX_iMultiFab.H>
@@ -41,12 +62,327 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 using namespace amrex;
 
+namespace
+{
+    /** Split the boxes whose cost is above max_box_cost and merge pairs of
+     * neighboring boxes whose total cost is below min_box_cost.
+     * The new boxes cover the same region as the boxes of ba. The cost of a box
+     * that is split is shared between the two halves, in proportion of their number
+     * of cells; boxes are only split at multiples of the blocking factor, and merged
+     * boxes do not exceed the maximum grid size.
+     *
+     * \param[in]  ba              current boxes
+     * \param[in]  box_costs       cost of each box of ba
+     * \param[in]  max_box_cost    boxes that cost more than this value are split
+     * \param[in]  min_box_cost    neighboring boxes that cost less than this value together are merged
+     * \param[in]  blocking_factor blocking factor of the level
+     * \param[in]  max_grid_size   maximum grid size of the level
+     * \param[out] new_costs       cost of each new box
+     */
+    BoxArray
+    SplitMergeBoxes (const BoxArray& ba, const Vector<Real>& box_costs,
+                     const Real max_box_cost, const Real min_box_cost,
+                     const IntVect& blocking_factor, const IntVect& max_grid_size,
+                     Vector<Real>& new_costs)
+    {
+        std::vector<Box> boxes;
+        new_costs.clear();
+
+        // Split the most expensive boxes in two halves, along their longest direction
+        // (in units of the blocking factor), until they are cheap enough or cannot be split
+        std::vector<std::pair<Box,Real>> to_split;
+        for (int i = 0; i < ba.size(); ++i) {
+            to_split.emplace_back(ba[i], box_costs[i]);
+            while (!to_split.empty()) {
+                auto [bx, cost] = to_split.back();
+                to_split.pop_back();
+                int split_dir = 0;
+                int nblocks = 0;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    const int n = bx.length(idim) / blocking_factor[idim];
+                    if (n > nblocks) {
+                        nblocks = n;
+                        split_dir = idim;
+                    }
+                }
+                if (cost > max_box_cost && nblocks >= 2) {
+                    Box lo = bx;
+                    const Box hi = lo.chop(split_dir,
+                        bx.smallEnd(split_dir) + (nblocks/2)*blocking_factor[split_dir]);
+                    const Real cost_lo = cost * static_cast<Real>(lo.numPts())
+                                              / static_cast<Real>(bx.numPts());
+                    to_split.emplace_back(hi, cost - cost_lo);
+                    to_split.emplace_back(lo, cost_lo);
+                } else {
+                    boxes.push_back(bx);
+                    new_costs.push_back(cost);
+                }
+            }
+        }
+
+        // Merge the cheapest boxes with a neighbor that shares a full face
+        const int nboxes = static_cast<int>(boxes.size());
+        std::unordered_map<IntVect, int, IntVect::shift_hasher> box_at_small_end;
+        for (int i = 0; i < nboxes; ++i) box_at_small_end[boxes[i].smallEnd()] = i;
+        std::vector<bool> merged(nboxes, false);
+        for (int i = 0; i < nboxes; ++i) {
+            if (merged[i]) continue;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                // Neighbor on the upper side of box i along idim
+                IntVect neighbor_small_end = boxes[i].smallEnd();
+                neighbor_small_end[idim] = boxes[i].bigEnd(idim) + 1;
+                const auto it = box_at_small_end.find(neighbor_small_end);
+                if (it == box_at_small_end.end()) continue;
+                const int j = it->second;
+                if (merged[j]) continue;
+                bool same_face = true;
+                for (int jdim = 0; jdim < AMREX_SPACEDIM; ++jdim) {
+                    if (jdim != idim && boxes[j].bigEnd(jdim) != boxes[i].bigEnd(jdim)) {
+                        same_face = false;
+                    }
+                }
+                if (same_face
+                    && boxes[i].length(idim) + boxes[j].length(idim) <= max_grid_size[idim]
+                    && new_costs[i] + new_costs[j] < min_box_cost)
+                {
+                    boxes[i].setBig(idim, boxes[j].bigEnd(idim));
+                    new_costs[i] += new_costs[j];
+                    merged[j] = true;
+                    break;
+                }
+            }
+        }
+
+        BoxList bl;
+        Vector<Real> merged_costs;
+        for (int i = 0; i < nboxes; ++i) {
+            if (merged[i]) continue;
+            bl.push_back(boxes[i]);
+            merged_costs.push_back(new_costs[i]);
+        }
+        new_costs = std::move(merged_costs);
+        return BoxArray(std::move(bl));
+    }
+
+    /** Morton index of a point with non-negative coordinates
+     * (the bits of the coordinates are interleaved) */
+    std::uint64_t MortonKey (const IntVect& iv)
+    {
+        constexpr int nbits = 64 / AMREX_SPACEDIM;
+        std::uint64_t key = 0;
+        for (int bit = 0; bit < nbits; ++bit) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const auto b = (static_cast<std::uint64_t>(iv[idim]) >> bit) & 1u;
+                key |= b << (bit*AMREX_SPACEDIM + idim);
+            }
+        }
+        return key;
+    }
+
+    /** Distribute the boxes of ba by cutting a space-filling curve (Morton order
+     * of the box centers) into nprocs segments of equal cost.
+     * This is a serial algorithm, in O(N log N) operations for N boxes: it is
+     * replicated on all ranks, which compute the same mapping from the same costs.
+     *
+     * \param[in] ba        boxes to distribute
+     * \param[in] box_costs cost of each box of ba
+     * \param[in] nprocs    number of MPI ranks
+     * \return owner of each box
+     */
+    Vector<int> SFCSplit (const BoxArray& ba, const Vector<Real>& box_costs, const int nprocs)
+    {
+        const int nboxes = static_cast<int>(ba.size());
+        const IntVect lo = ba.minimalBox().smallEnd();
+
+        // Order of the boxes along the curve (twice the center, to stay on integers)
+        Vector<std::pair<std::uint64_t,int>> order(nboxes);
+        for (int i = 0; i < nboxes; ++i) {
+            const Box& bx = ba[i];
+            order[i] = {MortonKey(bx.smallEnd() + bx.bigEnd() - 2*lo), i};
+        }
+        std::sort(order.begin(), order.end());
+
+        // Without costs, distribute the same number of boxes to each rank
+        const Real total_cost = std::accumulate(box_costs.begin(), box_costs.end(), Real(0.0));
+        const bool use_costs = total_cost > 0.0;
+        const Real cost_per_rank = (use_costs ? total_cost : Real(nboxes)) / nprocs;
+
+        // Each box goes to the rank whose segment of the curve contains its middle
+        Vector<int> pmap(nboxes);
+        Real prefix = 0.0;
+        for (const auto& key_box : order) {
+            const int i = key_box.second;
+            const Real c = use_costs ? box_costs[i] : Real(1.0);
+            const int rank = static_cast<int>((prefix + 0.5*c) / cost_per_rank);
+            pmap[i] = std::min(rank, nprocs-1);
+            prefix += c;
+        }
+        return pmap;
+    }
+
+    /** Efficiency of a distribution mapping: average cost per rank, normalized
+     * by the maximum cost of a rank */
+    Real MappingEfficiency (const Vector<int>& pmap, const Vector<Real>& box_costs, const int nprocs)
+    {
+        Vector<Real> rank_costs(nprocs, 0.0);
+        for (int i = 0; i < static_cast<int>(pmap.size()); ++i) {
+            rank_costs[pmap[i]] += box_costs[i];
+        }
+        const Real max_cost = *std::max_element(rank_costs.begin(), rank_costs.end());
+        if (max_cost <= 0.0) return 1.0;
+        return std::accumulate(rank_costs.begin(), rank_costs.end(), Real(0.0)) / (nprocs*max_cost);
+    }
+
+    /** Limit the number of cells that change owner between old_pmap and new_pmap
+     * to max_migration times the number of cells of ba. Starting from old_pmap,
+     * the moves of new_pmap are applied to the most loaded rank first, as long as
+     * they reduce its load and fit in the budget.
+     *
+     * \param[in]     ba            boxes of the level
+     * \param[in]     box_costs     cost of each box of ba
+     * \param[in]     old_pmap      current owner of each box
+     * \param[in,out] new_pmap      proposed owner of each box, then the capped one
+     * \param[in]     max_migration fraction of the cells of ba that can move
+     * \param[in]     nprocs        number of MPI ranks
+     */
+    void CapMigration (const BoxArray& ba, const Vector<Real>& box_costs,
+                       const Vector<int>& old_pmap, Vector<int>& new_pmap,
+                       const Real max_migration, const int nprocs)
+    {
+        const int nboxes = static_cast<int>(ba.size());
+        const auto budget = static_cast<Long>(max_migration * static_cast<Real>(ba.numPts()));
+
+        Long moved_cells = 0;
+        for (int i = 0; i < nboxes; ++i) {
+            if (new_pmap[i] != old_pmap[i]) moved_cells += ba[i].numPts();
+        }
+        if (moved_cells <= budget) return;
+
+        // Proposed moves out of each rank, the most expensive boxes first
+        Vector<Vector<int>> moves(nprocs);
+        Vector<Real> load(nprocs, 0.0);
+        for (int i = 0; i < nboxes; ++i) {
+            load[old_pmap[i]] += box_costs[i];
+            if (new_pmap[i] != old_pmap[i]) moves[old_pmap[i]].push_back(i);
+        }
+        for (auto& m : moves) {
+            std::sort(m.begin(), m.end(), [&box_costs] (int a, int b) {
+                return (box_costs[a] != box_costs[b]) ? (box_costs[a] > box_costs[b]) : (a < b);
+            });
+        }
+
+        Vector<int> pmap = old_pmap;
+        Vector<std::size_t> next_move(nprocs, 0);
+        std::priority_queue<std::pair<Real,int>> ranks;
+        for (int r = 0; r < nprocs; ++r) ranks.push({load[r], r});
+
+        Long used = 0;
+        while (!ranks.empty()) {
+            const auto [rank_load, r] = ranks.top();
+            ranks.pop();
+            if (rank_load != load[r]) continue; // outdated entry
+
+            bool moved = false;
+            while (!moved && next_move[r] < moves[r].size()) {
+                const int i = moves[r][next_move[r]++];
+                const int dst = new_pmap[i];
+                const Long cells = ba[i].numPts();
+                if (used + cells > budget || load[dst] + box_costs[i] >= load[r]) continue;
+                pmap[i] = dst;
+                load[r] -= box_costs[i];
+                load[dst] += box_costs[i];
+                used += cells;
+                ranks.push({load[r], r});
+                ranks.push({load[dst], dst});
+                moved = true;
+            }
+            // The most loaded rank cannot be relieved: the efficiency cannot improve
+            if (!moved) break;
+        }
+        new_pmap = std::move(pmap);
+    }
+
+    /** Solve the normal equations A w = b of a linear least-squares fit with n
+     * features (A is symmetric, row-major), with non-negative weights: the feature
+     * with the most negative weight is removed from the fit until all weights are
+     * non-negative. Features that are zero in all samples get a zero weight.
+     */
+    Vector<double> SolveNonNegative (const Vector<double>& A, const double* b, const int n)
+    {
+        Vector<int> active(n, 1);
+        Vector<double> w(n, 0.0);
+        for (int iter = 0; iter <= n; ++iter)
+        {
+            Vector<int> idx;
+            for (int i = 0; i < n; ++i) {
+                if (active[i] && A[i*n+i] > 0.0) idx.push_back(i);
+            }
+            const int m = static_cast<int>(idx.size());
+            std::fill(w.begin(), w.end(), 0.0);
+            if (m == 0) return w;
+
+            // System of the active features, scaled to a unit diagonal
+            // (the features have very different magnitudes), slightly regularized
+            Vector<double> scale(m), M(m*m), x(m);
+            for (int i = 0; i < m; ++i) scale[i] = std::sqrt(A[idx[i]*n+idx[i]]);
+            for (int i = 0; i < m; ++i) {
+                x[i] = b[idx[i]] / scale[i];
+                for (int j = 0; j < m; ++j) {
+                    M[i*m+j] = A[idx[i]*n+idx[j]] / (scale[i]*scale[j]);
+                }
+                M[i*m+i] += 1.e-10;
+            }
+
+            // Gaussian elimination with partial pivoting
+            for (int k = 0; k < m; ++k) {
+                int piv = k;
+                for (int i = k+1; i < m; ++i) {
+                    if (std::abs(M[i*m+k]) > std::abs(M[piv*m+k])) piv = i;
+                }
+                if (piv != k) {
+                    for (int j = 0; j < m; ++j) std::swap(M[k*m+j], M[piv*m+j]);
+                    std::swap(x[k], x[piv]);
+                }
+                for (int i = k+1; i < m; ++i) {
+                    const double f = M[i*m+k] / M[k*m+k];
+                    for (int j = k; j < m; ++j) M[i*m+j] -= f*M[k*m+j];
+                    x[i] -= f*x[k];
+                }
+            }
+            for (int i = m-1; i >= 0; --i) {
+                for (int j = i+1; j < m; ++j) x[i] -= M[i*m+j]*x[j];
+                x[i] /= M[i*m+i];
+            }
+
+            int most_negative = -1;
+            for (int i = 0; i < m; ++i) {
+                w[idx[i]] = x[i] / scale[i];
+                if (w[idx[i]] < 0.0 && (most_negative < 0 || w[idx[i]] < w[most_negative])) {
+                    most_negative = idx[i];
+                }
+            }
+            if (most_negative < 0) return w;
+            active[most_negative] = 0;
+        }
+        std::fill(w.begin(), w.end(), 0.0);
+        return w;
+    }
+
+    const std::array<const char*, CostPhase::NPhases> cost_phase_names = {
+        "particle push", "deposition", "field solve", "collisions", "ionization", "other"};
+}
+
 void
 WarpX::LoadBalance ()
 {
@@ -61,6 +397,11 @@ WarpX::LoadBalance ()
         // compute the costs on a per-rank basis
         ComputeCostsHeuristic(costs);
     }
+    else if (load_balance_costs_fit)
+    {
+        // replace the measured costs by the prediction of the fitted cost model
+        FitCostModel();
+    }
 
     // By default, do not do a redistribute; this toggles to true if RemakeLevel
     // is called for any level
@@ -71,6 +412,17 @@ WarpX::LoadBalance ()
     {
         int doLoadBalance = false;
 
+        if (load_balance_split_merge)
+        {
+            // Split the most expensive boxes and merge the cheapest ones, then
+            // compute the distribution mapping of the new boxes
+            if (LoadBalanceSplitMerge(lev))
+            {
+                loadBalancedAnyLevel = true;
+                continue;
+            }
+        }
+
         // Compute the new distribution mapping
         DistributionMapping newdm;
         const amrex::Real nboxes = costs[lev]->size();
@@ -81,45 +433,75 @@ WarpX::LoadBalance ()
         amrex::Real currentEfficiency = 0.0;
         amrex::Real proposedEfficiency = 0.0;
 
-        newdm = (load_balance_with_sfc)
-            ? DistributionMapping::makeSFC(*costs[lev],
-                                           currentEfficiency, proposedEfficiency,
-                                           false,
-                                           ParallelDescriptor::IOProcessorNumber())
-            : DistributionMapping::makeKnapSack(*costs[lev],
-                                                currentEfficiency, proposedEfficiency,
-                                                nmax,
-                                                false,
-                                                ParallelDescriptor::IOProcessorNumber());
-        // As specified in the above calls to makeSFC and makeKnapSack, the new
-        // distribution mapping is NOT communicated to all ranks; the loadbalanced
-        // dm is up-to-date only on root, and we can decide whether to broadcast
-        if ((load_balance_efficiency_ratio_threshold > 0.0)
-            && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()))
+        if (load_balance_distributed)
         {
-            doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
-        }
+            // Replicated serial SFC: the costs are gathered on all ranks, which all
+            // compute the same distribution mapping and the same decision
+            const int root = ParallelDescriptor::IOProcessorNumber();
+            Vector<Real> box_costs;
+            ParallelDescriptor::GatherLayoutDataToVector(*costs[lev], box_costs, root);
+            box_costs.resize(costs[lev]->size());
+            ParallelDescriptor::Bcast(box_costs.data(), box_costs.size(), root);
 
-        ParallelDescriptor::Bcast(&doLoadBalance, 1,
-                                  ParallelDescriptor::IOProcessorNumber());
+            const int np = ParallelContext::NProcsSub();
+            const Vector<int>& pmap = DistributionMap(lev).ProcessorMap();
+            Vector<int> new_pmap = SFCSplit(boxArray(lev), box_costs, np);
+            if (load_balance_max_migration < 1.0) {
+                CapMigration(boxArray(lev), box_costs, pmap, new_pmap,
+                             load_balance_max_migration, np);
+            }
+            currentEfficiency = MappingEfficiency(pmap, box_costs, np);
+            proposedEfficiency = MappingEfficiency(new_pmap, box_costs, np);
 
-        if (doLoadBalance)
+            doLoadBalance = (load_balance_efficiency_ratio_threshold > 0.0)
+                && (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+            if (doLoadBalance) newdm = DistributionMapping(new_pmap);
+        }
+        else
         {
-            Vector<int> pmap;
-            if (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber())
-            {
-                pmap = newdm.ProcessorMap();
-            } else
+            newdm = (load_balance_with_sfc)
+                ? DistributionMapping::makeSFC(*costs[lev],
+                                               currentEfficiency, proposedEfficiency,
+                                               false,
+                                               ParallelDescriptor::IOProcessorNumber())
+                : DistributionMapping::makeKnapSack(*costs[lev],
+                                                    currentEfficiency, proposedEfficiency,
+                                                    nmax,
+                                                    false,
+                                                    ParallelDescriptor::IOProcessorNumber());
+            // As specified in the above calls to makeSFC and makeKnapSack, the new
+            // distribution mapping is NOT communicated to all ranks; the loadbalanced
+            // dm is up-to-date only on root, and we can decide whether to broadcast
+            if ((load_balance_efficiency_ratio_threshold > 0.0)
+                && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()))
             {
-                pmap.resize(static_cast<std::size_t>(nboxes));
+                doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
             }
-            ParallelDescriptor::Bcast(pmap.data(), pmap.size(), ParallelDescriptor::IOProcessorNumber());
 
-            if (ParallelDescriptor::MyProc() != ParallelDescriptor::IOProcessorNumber())
+            ParallelDescriptor::Bcast(&doLoadBalance, 1,
+                                      ParallelDescriptor::IOProcessorNumber());
+
+            if (doLoadBalance)
             {
-                newdm = DistributionMapping(pmap);
+                Vector<int> pmap;
+                if (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber())
+                {
+                    pmap = newdm.ProcessorMap();
+                } else
+                {
+                    pmap.resize(static_cast<std::size_t>(nboxes));
+                }
+                ParallelDescriptor::Bcast(pmap.data(), pmap.size(), ParallelDescriptor::IOProcessorNumber());
+
+                if (ParallelDescriptor::MyProc() != ParallelDescriptor::IOProcessorNumber())
+                {
+                    newdm = DistributionMapping(pmap);
+                }
             }
+        }
 
+        if (doLoadBalance)
+        {
             RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
 
             // Record the load balance efficiency
@@ -145,91 +527,316 @@ WarpX::LoadBalance ()
 }
 
 
+bool
+WarpX::LoadBalanceSplitMerge (int lev)
+{
+#ifdef AMREX_USE_MPI
+    // A single-box FFT requires a single box
+    if (fft_periodic_single_box && !fft_distributed) return false;
+
+    const int root = ParallelDescriptor::IOProcessorNumber();
+
+    // Gather the costs of all the boxes on all MPI ranks, so that all ranks
+    // compute the same boxes and distribution mapping
+    Vector<Real> box_costs;
+    ParallelDescriptor::GatherLayoutDataToVector(*costs[lev], box_costs, root);
+    box_costs.resize(costs[lev]->size());
+    ParallelDescriptor::Bcast(box_costs.data(), box_costs.size(), root);
+
+    const amrex::Real nprocs = ParallelContext::NProcsSub();
+    const amrex::Real average_rank_cost =
+        std::accumulate(box_costs.begin(), box_costs.end(), amrex::Real(0.0)) / nprocs;
+    if (average_rank_cost <= 0.0) return false;
+
+    Vector<Real> new_costs;
+    const BoxArray newba = SplitMergeBoxes(
+        boxArray(lev), box_costs,
+        load_balance_split_ratio*average_rank_cost, load_balance_merge_ratio*average_rank_cost,
+        blockingFactor(lev), maxGridSize(lev), new_costs);
+    if (newba == boxArray(lev)) return false;
+
+    // Efficiency (average cost over all ranks, normalized to max cost)
+    // of the current boxes and distribution mapping
+    Vector<Real> rank_costs(ParallelContext::NProcsSub(), 0.0);
+    const DistributionMapping& dm = DistributionMap(lev);
+    for (int i = 0; i < static_cast<int>(box_costs.size()); ++i) {
+        rank_costs[dm[i]] += box_costs[i];
+    }
+    const amrex::Real currentEfficiency =
+        average_rank_cost / *std::max_element(rank_costs.begin(), rank_costs.end());
+
+    amrex::Real proposedEfficiency = 0.0;
+    const int nmax = static_cast<int>(std::ceil(new_costs.size()/nprocs*load_balance_knapsack_factor));
+    DistributionMapping newdm;
+    if (load_balance_distributed) {
+        const int np = ParallelContext::NProcsSub();
+        const Vector<int> new_pmap = SFCSplit(newba, new_costs, np);
+        proposedEfficiency = MappingEfficiency(new_pmap, new_costs, np);
+        newdm = DistributionMapping(new_pmap);
+    } else {
+        newdm = (load_balance_with_sfc)
+            ? DistributionMapping::makeSFC(new_costs, newba, proposedEfficiency)
+            : DistributionMapping::makeKnapSack(new_costs, proposedEfficiency, nmax);
+    }
+
+    int doLoadBalance = false;
+    if ((load_balance_efficiency_ratio_threshold > 0.0)
+        && (ParallelDescriptor::MyProc() == root))
+    {
+        doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+    }
+    ParallelDescriptor::Bcast(&doLoadBalance, 1, root);
+
+    if (doLoadBalance)
+    {
+        RemakeLevel(lev, t_new[lev], newba, newdm);
+
+        // Record the load balance efficiency
+        setLoadBalanceEfficiency(lev, proposedEfficiency);
+    }
+    return doLoadBalance;
+#else
+    amrex::ignore_unused(lev);
+    return false;
+#endif
+}
+
 template <typename MultiFabType> void
-RemakeMultiFab (std::unique_ptr<MultiFabType>& mf, const DistributionMapping& dm,
-                const bool redistribute)
+RemakeMultiFab (std::unique_ptr<MultiFabType>& mf, const BoxArray& ba,
+                const DistributionMapping& dm, const bool redistribute)
 {
     if (mf == nullptr) return;
     const IntVect& ng = mf->nGrowVect();
-    auto pmf = std::make_unique<MultiFabType>(mf->boxArray(), dm, mf->nComp(), ng);
-    if (redistribute) pmf->Redistribute(*mf, 0, 0, mf->nComp(), ng);
+    // ba is cell-centered: give it the index type of mf
+    const BoxArray new_ba = amrex::convert(ba, mf->ixType());
+    if (new_ba == mf->boxArray()) {
+        // Only the boxes that change owner are allocated (and sent, if redistribute);
+        // the others keep their memory and data
+        ablastr::utils::communication::Redistribute(*mf, dm, redistribute);
+        return;
+    }
+    auto pmf = std::make_unique<MultiFabType>(new_ba, dm, mf->nComp(), ng);
+    if (redistribute) {
+        // The boxes were split or merged: the valid data (and most guard cells)
+        // is copied where the old and new boxes overlap
+        pmf->setVal(0);
+        pmf->ParallelCopy(*mf, 0, 0, mf->nComp(), ng, ng);
+    }
     mf = std::move(pmf);
 }
 
+namespace
+{
+    /** Fill the valid points of mf with the data of the coarser level crse,
+     * interpolated linearly along the nodal directions and piecewise constant
+     * along the cell-centered ones.
+     *
+     * \param[in,out] mf      data to fill
+     * \param[in]     crse    data of the coarser level, with the same index type as mf
+     * \param[in]     cgeom   geometry of the coarser level
+     * \param[in]     r_ratio refinement ratio between mf and crse (1 for a coarse patch)
+     */
+    void
+    InterpolateFromCoarse (MultiFab& mf, const MultiFab& crse, const Geometry& cgeom, const int r_ratio)
+    {
+        const IntVect type = mf.ixType().toIntVect();
+        const int ncomp = mf.nComp();
+
+        // Coarse data on the coarsened boxes of mf, with one guard cell for the interpolation
+        BoxArray cba = mf.boxArray();
+        cba.coarsen(r_ratio);
+        MultiFab crse_tmp(cba, mf.DistributionMap(), ncomp, 1);
+        crse_tmp.setVal(0._rt);
+        crse_tmp.ParallelCopy(crse, 0, 0, ncomp, IntVect(0), IntVect(1), cgeom.periodicity());
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            for (int n = 0; n < ncomp; ++n) {
+                Array4<Real> const fine(mf.array(mfi), n);
+                Array4<Real const> const coarse(crse_tmp.const_array(mfi), n);
+                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
+                {
+                    Interpolate::interp(j, k, l, fine, coarse, r_ratio, type);
+                });
+            }
+        }
+    }
+
+    /** Same as RemakeMultiFab with redistribution, for a level whose region changes:
+     * the data is interpolated from the coarser level, and the old data
+     * is kept where the old and new boxes overlap.
+     *
+     * \param[in,out] mf      data to remake
+     * \param[in]     ba      new cell-centered boxes
+     * \param[in]     dm      new distribution mapping
+     * \param[in]     crse    data of the coarser level (if nullptr, the new region is set to 0)
+     * \param[in]     cgeom   geometry of the coarser level
+     * \param[in]     r_ratio refinement ratio between mf and crse (1 for a coarse patch)
+     */
+    void
+    RemakeMultiFabFromCoarse (std::unique_ptr<MultiFab>& mf, const BoxArray& ba,
+                              const DistributionMapping& dm, const MultiFab* crse,
+                              const Geometry& cgeom, const int r_ratio)
+    {
+        if (mf == nullptr) return;
+        if (crse == nullptr) {
+            RemakeMultiFab(mf, ba, dm, true);
+            return;
+        }
+        const IntVect& ng = mf->nGrowVect();
+        auto pmf = std::make_unique<MultiFab>(amrex::convert(ba, mf->ixType()), dm, mf->nComp(), ng);
+        pmf->setVal(0);
+        InterpolateFromCoarse(*pmf, *crse, cgeom, r_ratio);
+        pmf->ParallelCopy(*mf, 0, 0, mf->nComp(), IntVect(0), IntVect(0));
+        mf = std::move(pmf);
+    }
+}
+
 void
 WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
 {
-    if (ba == boxArray(lev))
+    // The filter scratch MultiFabs are reallocated on the new grids when needed
+    ClearFilterScratch();
+
+    // With load balancing, the boxes are only split or merged and cover the same region.
+    // With regridding (lev > 0), the region of the level can change: the fields that
+    // are evolved in time are then interpolated from the coarser level where the
+    // old and new boxes do not overlap (the PML of the patch is rebuilt by RegridLevels)
+    const bool same_ba = (ba == boxArray(lev));
+    if (same_ba && ParallelContext::NProcsSub() == 1) return;
+    const bool same_region = same_ba || (ba.numPts() == boxArray(lev).numPts()
+                                         && ba.contains(boxArray(lev)));
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        same_region || lev > 0,
+        "RemakeLevel: the new BoxArray of level 0 must cover the same region as the current one");
+
+    // Coarse patch and buffers of the level
+    BoxArray cba = ba;
+    const int r_ratio = (lev > 0) ? refRatio(lev-1)[0] : 1;
+    if (lev > 0) cba.coarsen(refRatio(lev-1));
+
+    // Data of the coarser level (if any) used to fill the new region of the level
+    auto crse_vector = [&] (const auto& field, const int idim) -> const MultiFab* {
+        return (lev > 0) ? field[lev-1][idim].get() : nullptr;
+    };
+    auto crse_scalar = [&] (const auto& field) -> const MultiFab* {
+        return (lev > 0) ? field[lev-1].get() : nullptr;
+    };
+    // r is the refinement ratio with respect to crse: 1 for the coarse patch
+    auto remake_evolved = [&] (std::unique_ptr<MultiFab>& mf, const BoxArray& new_ba,
+                               const MultiFab* crse, const int r)
     {
-        if (ParallelDescriptor::NProcs() == 1) return;
+        if (same_region) {
+            RemakeMultiFab(mf, new_ba, dm, true);
+        } else {
+            RemakeMultiFabFromCoarse(mf, new_ba, dm, crse, Geom(lev-1), r);
+        }
+    };
 
-        // Fine patch
-        for (int idim=0; idim < 3; ++idim)
-        {
-            RemakeMultiFab(Bfield_fp[lev][idim], dm, true);
-            RemakeMultiFab(Efield_fp[lev][idim], dm, true);
-            RemakeMultiFab(current_fp[lev][idim], dm, false);
-            RemakeMultiFab(current_store[lev][idim], dm, false);
+    // Fine patch
+    for (int idim=0; idim < 3; ++idim)
+    {
+        remake_evolved(Bfield_fp[lev][idim], ba, crse_vector(Bfield_fp, idim), r_ratio);
+        remake_evolved(Efield_fp[lev][idim], ba, crse_vector(Efield_fp, idim), r_ratio);
+        remake_evolved(Bfield_avg_fp[lev][idim], ba, crse_vector(Bfield_avg_fp, idim), r_ratio);
+        remake_evolved(Efield_avg_fp[lev][idim], ba, crse_vector(Efield_avg_fp, idim), r_ratio);
+        RemakeMultiFab(current_fp[lev][idim], ba, dm, false);
+        RemakeMultiFab(current_store[lev][idim], ba, dm, false);
+        RemakeMultiFab(current_fp_nodal[lev][idim], ba, dm, false);
+        RemakeMultiFab(current_fp_vay[lev][idim], ba, dm, false);
 
 #ifdef AMREX_USE_EB
-            if (WarpX::maxwell_solver_id == MaxwellSolverAlgo::Yee ||
-                WarpX::maxwell_solver_id == MaxwellSolverAlgo::ECT ||
-                WarpX::maxwell_solver_id == MaxwellSolverAlgo::CKC){
-                RemakeMultiFab(m_edge_lengths[lev][idim], dm, false);
-                RemakeMultiFab(m_face_areas[lev][idim], dm, false);
-                if(WarpX::maxwell_solver_id == MaxwellSolverAlgo::ECT){
-                    RemakeMultiFab(Venl[lev][idim], dm, false);
-                    RemakeMultiFab(m_flag_info_face[lev][idim], dm, false);
-                    RemakeMultiFab(m_flag_ext_face[lev][idim], dm, false);
-                    RemakeMultiFab(m_area_mod[lev][idim], dm, false);
-                    RemakeMultiFab(ECTRhofield[lev][idim], dm, false);
+        if (WarpX::maxwell_solver_id == MaxwellSolverAlgo::Yee ||
+            WarpX::maxwell_solver_id == MaxwellSolverAlgo::ECT ||
+            WarpX::maxwell_solver_id == MaxwellSolverAlgo::CKC){
+            // With the same BoxArray, the EB geometry of each box is moved
+            // to its new owner instead of being recomputed
+            RemakeMultiFab(m_edge_lengths[lev][idim], ba, dm, same_ba);
+            RemakeMultiFab(m_face_areas[lev][idim], ba, dm, same_ba);
+            if(WarpX::maxwell_solver_id == MaxwellSolverAlgo::ECT){
+                RemakeMultiFab(Venl[lev][idim], ba, dm, false);
+                // Same for the face extensions, which are only computed on the finest level
+                RemakeMultiFab(m_flag_info_face[lev][idim], ba, dm, same_ba);
+                RemakeMultiFab(m_flag_ext_face[lev][idim], ba, dm, same_ba);
+                RemakeMultiFab(m_area_mod[lev][idim], ba, dm, same_ba);
+                RemakeMultiFab(ECTRhofield[lev][idim], ba, dm, false);
+                if (same_ba && lev == maxLevel()) {
+                    RedistributeBorrowing(lev, idim, dm);
+                } else {
                     m_borrowing[lev][idim] = std::make_unique<amrex::LayoutData<FaceInfoBox>>(amrex::convert(ba, Bfield_fp[lev][idim]->ixType().toIntVect()), dm);
                 }
             }
-#endif
         }
+#endif
+    }
 
-        RemakeMultiFab(F_fp[lev], dm, true);
-        RemakeMultiFab(rho_fp[lev], dm, false);
-        // phi_fp should be redistributed since we use the solution from
-        // the last step as the initial guess for the next solve
-        RemakeMultiFab(phi_fp[lev], dm, true);
+    remake_evolved(F_fp[lev], ba, crse_scalar(F_fp), r_ratio);
+    remake_evolved(G_fp[lev], ba, crse_scalar(G_fp), r_ratio);
+    RemakeMultiFab(rho_fp[lev], ba, dm, false);
+    // phi_fp should be redistributed since we use the solution from
+    // the last step as the initial guess for the next solve
+    remake_evolved(phi_fp[lev], ba, crse_scalar(phi_fp), r_ratio);
 
 #ifdef AMREX_USE_EB
-        RemakeMultiFab(m_distance_to_eb[lev], dm, false);
+    RemakeMultiFab(m_distance_to_eb[lev], ba, dm, same_ba);
 
-        int max_guard = guard_cells.ng_FieldSolver.max();
-        m_field_factory[lev] = amrex::makeEBFabFactory(Geom(lev), ba, dm,
-                                                       {max_guard, max_guard, max_guard},
-                                                       amrex::EBSupport::full);
+    int max_guard = guard_cells.ng_FieldSolver.max();
+    m_field_factory[lev] = amrex::makeEBFabFactory(Geom(lev), ba, dm,
+                                                   {max_guard, max_guard, max_guard},
+                                                   amrex::EBSupport::full);
 
+    // With the same BoxArray, the EB geometry and the ECT face extensions
+    // were moved with their boxes above
+    if (same_ba) {
+        if (lev == maxLevel() && m_fdtd_solver_fp[lev] &&
+            (WarpX::maxwell_solver_id == MaxwellSolverAlgo::Yee ||
+             WarpX::maxwell_solver_id == MaxwellSolverAlgo::CKC ||
+             WarpX::maxwell_solver_id == MaxwellSolverAlgo::ECT)) {
+            // The tile classification is local to each rank
+            m_fdtd_solver_fp[lev]->ClassifyEBTiles(m_edge_lengths[lev], m_face_areas[lev]);
+        }
+    } else {
         InitializeEBGridData(lev);
+    }
 #else
-        m_field_factory[lev] = std::make_unique<FArrayBoxFactory>();
+    m_field_factory[lev] = std::make_unique<FArrayBoxFactory>();
 #endif
 
 #ifdef WARPX_USE_PSATD
-        if (maxwell_solver_id == MaxwellSolverAlgo::PSATD) {
-            if (spectral_solver_fp[lev] != nullptr) {
-                // Get the cell-centered box
-                BoxArray realspace_ba = ba;   // Copy box
-                realspace_ba.enclosedCells(); // Make it cell-centered
-                auto ngEB = getngEB();
-                auto dx = CellSize(lev);
+    if (maxwell_solver_id == MaxwellSolverAlgo::PSATD) {
+        if (spectral_solver_fp[lev] != nullptr) {
+            // Get the cell-centered box
+            BoxArray realspace_ba = ba;   // Copy box
+            realspace_ba.enclosedCells(); // Make it cell-centered
+            auto ngEB = getngEB();
+            auto dx = CellSize(lev);
 
 #   ifdef WARPX_DIM_RZ
-                if ( fft_periodic_single_box == false ) {
-                    realspace_ba.grow(1, ngEB[1]); // add guard cells only in z
-                }
+            if ( fft_periodic_single_box == false ) {
+                realspace_ba.grow(1, ngEB[1]); // add guard cells only in z
+            }
+            if (same_ba) {
+                // Move the spectral coefficients with their boxes
+                spectral_solver_fp[lev]->RemakeDistributionMapping(lev, realspace_ba, dm);
+            } else {
                 AllocLevelSpectralSolverRZ(spectral_solver_fp,
                                            lev,
                                            realspace_ba,
                                            dm,
                                            dx);
+            }
 #   else
-                if ( fft_periodic_single_box == false ) {
-                    realspace_ba.grow(ngEB);   // add guard cells
-                }
+            if ( fft_periodic_single_box == false ) {
+                realspace_ba.grow(ngEB);   // add guard cells
+            }
+            if (same_ba) {
+                // Move the spectral coefficients with their boxes
+                spectral_solver_fp[lev]->RemakeDistributionMapping(lev, realspace_ba, dm);
+            } else {
                 bool const pml_flag_false = false;
                 AllocLevelSpectralSolver(spectral_solver_fp,
                                          lev,
@@ -237,59 +844,71 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
                                          dm,
                                          dx,
                                          pml_flag_false);
-#   endif
             }
+#   endif
         }
+    }
 #endif
 
-        // Aux patch
-        if (lev == 0 && Bfield_aux[0][0]->ixType() == Bfield_fp[0][0]->ixType())
+    // Aux patch
+    if (lev == 0 && Bfield_aux[0][0]->ixType() == Bfield_fp[0][0]->ixType())
+    {
+        // The aux patch is an alias of the fine patch (or of its time average)
+        const auto& Bfield_src = (WarpX::fft_do_time_averaging) ? Bfield_avg_fp : Bfield_fp;
+        const auto& Efield_src = (WarpX::fft_do_time_averaging) ? Efield_avg_fp : Efield_fp;
+        for (int idim = 0; idim < 3; ++idim) {
+            Bfield_aux[lev][idim] = std::make_unique<MultiFab>(*Bfield_src[lev][idim], amrex::make_alias, 0, Bfield_aux[lev][idim]->nComp());
+            Efield_aux[lev][idim] = std::make_unique<MultiFab>(*Efield_src[lev][idim], amrex::make_alias, 0, Efield_aux[lev][idim]->nComp());
+        }
+    } else {
+        for (int idim=0; idim < 3; ++idim)
         {
-            for (int idim = 0; idim < 3; ++idim) {
-                Bfield_aux[lev][idim] = std::make_unique<MultiFab>(*Bfield_fp[lev][idim], amrex::make_alias, 0, Bfield_aux[lev][idim]->nComp());
-                Efield_aux[lev][idim] = std::make_unique<MultiFab>(*Efield_fp[lev][idim], amrex::make_alias, 0, Efield_aux[lev][idim]->nComp());
-            }
-        } else {
-            for (int idim=0; idim < 3; ++idim)
-            {
-                RemakeMultiFab(Bfield_aux[lev][idim], dm, false);
-                RemakeMultiFab(Efield_aux[lev][idim], dm, false);
-            }
+            RemakeMultiFab(Bfield_aux[lev][idim], ba, dm, false);
+            RemakeMultiFab(Efield_aux[lev][idim], ba, dm, false);
         }
+    }
 
-        // Coarse patch
-        if (lev > 0) {
-            for (int idim=0; idim < 3; ++idim)
-            {
-                RemakeMultiFab(Bfield_cp[lev][idim], dm, true);
-                RemakeMultiFab(Efield_cp[lev][idim], dm, true);
-                RemakeMultiFab(current_cp[lev][idim], dm, false);
-            }
-            RemakeMultiFab(F_cp[lev], dm, true);
-            RemakeMultiFab(rho_cp[lev], dm, false);
+    // Coarse patch
+    if (lev > 0) {
+        for (int idim=0; idim < 3; ++idim)
+        {
+            remake_evolved(Bfield_cp[lev][idim], cba, crse_vector(Bfield_fp, idim), 1);
+            remake_evolved(Efield_cp[lev][idim], cba, crse_vector(Efield_fp, idim), 1);
+            remake_evolved(Bfield_avg_cp[lev][idim], cba, crse_vector(Bfield_avg_fp, idim), 1);
+            remake_evolved(Efield_avg_cp[lev][idim], cba, crse_vector(Efield_avg_fp, idim), 1);
+            RemakeMultiFab(current_cp[lev][idim], cba, dm, false);
+        }
+        remake_evolved(F_cp[lev], cba, crse_scalar(F_fp), 1);
+        remake_evolved(G_cp[lev], cba, crse_scalar(G_fp), 1);
+        RemakeMultiFab(rho_cp[lev], cba, dm, false);
 
 #ifdef WARPX_USE_PSATD
-            if (maxwell_solver_id == MaxwellSolverAlgo::PSATD) {
-                if (spectral_solver_cp[lev] != nullptr) {
-                    BoxArray cba = ba;
-                    cba.coarsen(refRatio(lev-1));
-                    std::array<Real,3> cdx = CellSize(lev-1);
+        if (maxwell_solver_id == MaxwellSolverAlgo::PSATD) {
+            if (spectral_solver_cp[lev] != nullptr) {
+                std::array<Real,3> cdx = CellSize(lev-1);
 
-                    // Get the cell-centered box
-                    BoxArray c_realspace_ba = cba;  // Copy box
-                    c_realspace_ba.enclosedCells(); // Make it cell-centered
+                // Get the cell-centered box
+                BoxArray c_realspace_ba = cba;  // Copy box
+                c_realspace_ba.enclosedCells(); // Make it cell-centered
 
-                    auto ngEB = getngEB();
+                auto ngEB = getngEB();
 
 #   ifdef WARPX_DIM_RZ
-                    c_realspace_ba.grow(1, ngEB[1]); // add guard cells only in z
+                c_realspace_ba.grow(1, ngEB[1]); // add guard cells only in z
+                if (same_ba) {
+                    spectral_solver_cp[lev]->RemakeDistributionMapping(lev, c_realspace_ba, dm);
+                } else {
                     AllocLevelSpectralSolverRZ(spectral_solver_cp,
                                                lev,
                                                c_realspace_ba,
                                                dm,
                                                cdx);
+                }
 #   else
-                    c_realspace_ba.grow(ngEB);
+                c_realspace_ba.grow(ngEB);
+                if (same_ba) {
+                    spectral_solver_cp[lev]->RemakeDistributionMapping(lev, c_realspace_ba, dm);
+                } else {
                     bool const pml_flag_false = false;
                     AllocLevelSpectralSolver(spectral_solver_cp,
                                              lev,
@@ -297,44 +916,59 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
                                              dm,
                                              cdx,
                                              pml_flag_false);
-#   endif
                 }
+#   endif
             }
-#endif
         }
+#endif
+    }
 
-        if (lev > 0 && (n_field_gather_buffer > 0 || n_current_deposition_buffer > 0)) {
-            for (int idim=0; idim < 3; ++idim)
-            {
-                RemakeMultiFab(Bfield_cax[lev][idim], dm, false);
-                RemakeMultiFab(Efield_cax[lev][idim], dm, false);
-                RemakeMultiFab(current_buf[lev][idim], dm, false);
-            }
-            RemakeMultiFab(charge_buf[lev], dm, false);
-            // we can avoid redistributing these since we immediately re-build the values via BuildBufferMasks()
-            RemakeMultiFab(current_buffer_masks[lev], dm, false);
-            RemakeMultiFab(gather_buffer_masks[lev], dm, false);
-
-            if (current_buffer_masks[lev] || gather_buffer_masks[lev])
-                BuildBufferMasks();
+    if (lev > 0 && (n_field_gather_buffer > 0 || n_current_deposition_buffer > 0)) {
+        for (int idim=0; idim < 3; ++idim)
+        {
+            RemakeMultiFab(Bfield_cax[lev][idim], cba, dm, false);
+            RemakeMultiFab(Efield_cax[lev][idim], cba, dm, false);
+            RemakeMultiFab(current_buf[lev][idim], cba, dm, false);
         }
+        RemakeMultiFab(charge_buf[lev], cba, dm, false);
+        // we can avoid redistributing these since we immediately re-build the values via BuildBufferMasks()
+        RemakeMultiFab(current_buffer_masks[lev], ba, dm, false);
+        RemakeMultiFab(gather_buffer_masks[lev], ba, dm, false);
+
+        if (current_buffer_masks[lev] || gather_buffer_masks[lev])
+            BuildBufferMasks();
+    }
 
-        if (costs[lev] != nullptr)
+    if (costs[lev] != nullptr)
+    {
+        costs[lev] = std::make_unique<LayoutData<Real>>(ba, dm);
+        const auto iarr = costs[lev]->IndexArray();
+        for (int i : iarr)
         {
-            costs[lev] = std::make_unique<LayoutData<Real>>(ba, dm);
-            const auto iarr = costs[lev]->IndexArray();
-            for (int i : iarr)
-            {
-                (*costs[lev])[i] = 0.0;
-                setLoadBalanceEfficiency(lev, -1);
-            }
+            (*costs[lev])[i] = 0.0;
+            setLoadBalanceEfficiency(lev, -1);
         }
+    }
+    if (cost_phases[lev] != nullptr)
+    {
+        cost_phases[lev] = std::make_unique<CostPhasesLayout>(ba, dm);
+        for (int i : cost_phases[lev]->IndexArray()) (*cost_phases[lev])[i].fill(0.0);
+    }
 
-        SetDistributionMap(lev, dm);
+    // The PML has its own boxes around the region covered by the level, which is
+    // unchanged by load balancing: it is kept. In RZ, the PML is defined on the grids
+    // of level 0 instead, and is moved with them.
+#if (defined WARPX_DIM_RZ) && (defined WARPX_USE_PSATD)
+    if (lev == 0 && pml_rz[0]) pml_rz[0]->Remake(ba, dm);
+#endif
 
-    } else
-    {
-        amrex::Abort("RemakeLevel: to be implemented");
+    if (!same_ba) SetBoxArray(lev, ba);
+    SetDistributionMap(lev, dm);
+
+    // The properties of the macroscopic medium are defined on the grids of level 0:
+    // they are recomputed from their definition (constant or parser) on the new grids
+    if (lev == 0 && em_solver_medium == MediumForEM::Macroscopic) {
+        m_macroscopic_properties->InitData();
     }
 
     // Re-initialize diagnostic functors that stores pointers to the user-requested fields at level, lev.
@@ -344,6 +978,117 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
     // not needed yet
 }
 
+// This is a virtual function.
+void
+WarpX::MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
+                               const DistributionMapping& dm)
+{
+    AllocLevelData(lev, ba, dm);
+
+    t_new[lev] = time;
+    t_old[lev] = t_old[lev-1];
+    istep[lev] = istep[lev-1];
+
+    // The fine patch is interpolated from the fine patch of the coarser level,
+    // and the coarse patch (which has the resolution of the coarser level) is copied from it
+    const int r_ratio = refRatio(lev-1)[0];
+    const Geometry& cgeom = Geom(lev-1);
+    auto fill_from_coarse = [&] (const std::unique_ptr<MultiFab>& fp,
+                                 const std::unique_ptr<MultiFab>& cp,
+                                 const std::unique_ptr<MultiFab>& crse)
+    {
+        if (crse == nullptr) {
+            if (fp) fp->setVal(0.0);
+            if (cp) cp->setVal(0.0);
+            return;
+        }
+        if (fp) InterpolateFromCoarse(*fp, *crse, cgeom, r_ratio);
+        if (cp) InterpolateFromCoarse(*cp, *crse, cgeom, 1);
+    };
+
+    for (int idim = 0; idim < 3; ++idim)
+    {
+        fill_from_coarse(Efield_fp[lev][idim], Efield_cp[lev][idim], Efield_fp[lev-1][idim]);
+        fill_from_coarse(Bfield_fp[lev][idim], Bfield_cp[lev][idim], Bfield_fp[lev-1][idim]);
+        fill_from_coarse(Efield_avg_fp[lev][idim], Efield_avg_cp[lev][idim], Efield_avg_fp[lev-1][idim]);
+        fill_from_coarse(Bfield_avg_fp[lev][idim], Bfield_avg_cp[lev][idim], Bfield_avg_fp[lev-1][idim]);
+
+        // The aux patch is computed from the fine and coarse patches by UpdateAuxilaryData,
+        // and the currents are deposited again at the next step
+        Efield_aux[lev][idim]->setVal(0.0);
+        Bfield_aux[lev][idim]->setVal(0.0);
+        for (auto const& j : {current_fp[lev][idim].get(), current_cp[lev][idim].get(),
+                              current_store[lev][idim].get(), current_fp_nodal[lev][idim].get(),
+                              current_fp_vay[lev][idim].get()}) {
+            if (j) j->setVal(0.0);
+        }
+    }
+    fill_from_coarse(F_fp[lev], F_cp[lev], F_fp[lev-1]);
+    fill_from_coarse(G_fp[lev], G_cp[lev], G_fp[lev-1]);
+    // Initial guess of the electrostatic solver
+    fill_from_coarse(phi_fp[lev], nullptr, phi_fp[lev-1]);
+    if (rho_fp[lev]) rho_fp[lev]->setVal(0.0);
+    if (rho_cp[lev]) rho_cp[lev]->setVal(0.0);
+
+#ifdef AMREX_USE_EB
+    InitializeEBGridData(lev);
+#endif
+
+    multi_diags->InitializeFieldFunctors(lev);
+}
+
+void
+WarpX::RegridLevels (Real time)
+{
+    WARPX_PROFILE("WarpX::RegridLevels()");
+
+    // The particles must be in the boxes that contain them to be counted by the tagging
+    mypc->Redistribute();
+
+    const int old_finest_level = finest_level;
+    Vector<BoxArray> old_grids(old_finest_level+1);
+    for (int lev = 1; lev <= old_finest_level; ++lev) {
+        old_grids[lev] = boxArray(lev);
+    }
+
+    // Calls ErrorEst, then RemakeLevel, MakeNewLevelFromCoarse and ClearLevel
+    regrid(0, time);
+
+    // Move the particles to the level that now covers them (including the particles
+    // of the levels that were removed), then allocate the particle data of the new levels
+    mypc->Redistribute();
+    mypc->AllocData();
+
+    bool levels_changed = (finest_level != old_finest_level);
+    for (int lev = 1; lev <= finest_level; ++lev)
+    {
+        if (lev <= old_finest_level && boxArray(lev) == old_grids[lev]) continue;
+        levels_changed = true;
+        // The PML surrounds the new region of the patch
+        if (do_pml) {
+            InitPMLPatch(lev);
+            pml[lev]->ComputePMLFactors(dt[lev]);
+        }
+    }
+    if (!levels_changed) return;
+
+    // The buffer masks depend on the boxes of all the levels
+    if (n_field_gather_buffer > 0 || n_current_deposition_buffer > 0) {
+        BuildBufferMasks();
+    }
+
+    multi_diags->RemakeLevels();
+
+    if (verbose) {
+        amrex::Print() << Utils::TextMsg::Info("Regridding: " + std::to_string(finest_level)
+                                               + " refined level(s)");
+        for (int lev = 1; lev <= finest_level; ++lev) {
+            amrex::Print() << "  level " << lev << ": " << boxArray(lev).size() << " boxes, "
+                           << boxArray(lev).numPts() << " cells\n";
+        }
+    }
+}
+
 void
 WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<amrex::Real> > >& a_costs)
 {
@@ -374,6 +1119,100 @@ WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<am
     }
 }
 
+void
+WarpX::FitCostModel ()
+{
+    WARPX_PROFILE("WarpX::FitCostModel()");
+
+    const auto & mypc_ref = GetInstance().GetPartContainer();
+    const int nSpecies = mypc_ref.nSpecies();
+    // Features of a box: number of cells, and number of macroparticles of each species
+    const int nf = 1 + nSpecies;
+    constexpr int nphases = CostPhase::NPhases;
+
+    Vector<std::unique_ptr<LayoutData<Vector<double>>>> features(finest_level+1);
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        features[lev] = std::make_unique<LayoutData<Vector<double>>>(boxArray(lev), DistributionMap(lev));
+        for (int i : features[lev]->IndexArray())
+        {
+            auto& x = (*features[lev])[i];
+            x.assign(nf, 0.0);
+            x[0] = static_cast<double>(boxArray(lev)[i].numPts());
+        }
+        for (int i_s = 0; i_s < nSpecies; ++i_s)
+        {
+            auto & myspc = mypc_ref.GetParticleContainer(i_s);
+            for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+            {
+                (*features[lev])[pti.index()][1+i_s] += static_cast<double>(pti.numParticles());
+            }
+        }
+    }
+
+    // Normal equations of the least-squares fit over all boxes:
+    // sum of x x^T, then sum of x y for the measured cost y of each phase
+    Vector<double> sums(nf*nf + nphases*nf, 0.0);
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (cost_phases[lev] == nullptr) continue;
+        for (int i : features[lev]->IndexArray())
+        {
+            const auto& x = (*features[lev])[i];
+            const auto& y = (*cost_phases[lev])[i];
+            for (int a = 0; a < nf; ++a) {
+                for (int b = 0; b < nf; ++b) sums[a*nf+b] += x[a]*x[b];
+                for (int p = 0; p < nphases; ++p) sums[nf*nf + p*nf + a] += x[a]*y[p];
+            }
+        }
+    }
+    ParallelAllReduce::Sum(sums.data(), static_cast<int>(sums.size()), ParallelContext::CommunicatorSub());
+
+    // Online update: the equations of the previous load balances are kept with a decreasing weight
+    if (static_cast<int>(m_costs_fit_matrix.size()) != nf*nf)
+    {
+        m_costs_fit_matrix.assign(nf*nf, 0.0);
+        m_costs_fit_rhs.assign(nphases*nf, 0.0);
+    }
+    const double memory = load_balance_costs_fit_memory;
+    for (int k = 0; k < nf*nf; ++k) {
+        m_costs_fit_matrix[k] = memory*m_costs_fit_matrix[k] + sums[k];
+    }
+    for (int k = 0; k < nphases*nf; ++k) {
+        m_costs_fit_rhs[k] = memory*m_costs_fit_rhs[k] + sums[nf*nf + k];
+    }
+
+    Vector<double> weights(nphases*nf);
+    for (int p = 0; p < nphases; ++p)
+    {
+        const Vector<double> w = SolveNonNegative(m_costs_fit_matrix, &m_costs_fit_rhs[p*nf], nf);
+        std::copy(w.begin(), w.end(), weights.begin() + p*nf);
+    }
+
+    if (verbose)
+    {
+        amrex::Print() << "Load balance cost model (weight per cell, then per macroparticle of each species):\n";
+        for (int p = 0; p < nphases; ++p)
+        {
+            amrex::Print() << "  " << cost_phase_names[p] << ":";
+            for (int a = 0; a < nf; ++a) amrex::Print() << " " << weights[p*nf+a];
+            amrex::Print() << "\n";
+        }
+    }
+
+    // Predicted cost of each box, for its current number of cells and macroparticles
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        for (int i : features[lev]->IndexArray())
+        {
+            const auto& x = (*features[lev])[i];
+            double predicted = 0.0;
+            for (int k = 0; k < nphases*nf; ++k) predicted += weights[k]*x[k % nf];
+            (*costs[lev])[i] = static_cast<Real>(predicted);
+        }
+    }
+}
+
 void
 WarpX::ResetCosts ()
 {
@@ -385,5 +1224,9 @@ WarpX::ResetCosts ()
             // Reset costs
             (*costs[lev])[i] = 0.0;
         }
+        if (cost_phases[lev])
+        {
+            for (int i : cost_phases[lev]->IndexArray()) (*cost_phases[lev])[i].fill(0.0);
+        }
     }
 }
@@ -101,7 +101,7 @@ BackgroundStopping::doCollisions (amrex::Real cur_time, amrex::Real dt, MultiPar
             {
                 amrex::Gpu::synchronize();
             }
-            amrex::Real wt = amrex::second();
+            amrex::Real wt = WarpXUtilLoadBalance::CostClock();
 
             if (background_type == BackgroundStoppingType::ELECTRONS) {
                 doBackgroundStoppingOnElectronsWithinTile(pti, dt, cur_time, species_mass, species_charge);
@@ -112,8 +112,8 @@ BackgroundStopping::doCollisions (amrex::Real cur_time, amrex::Real dt, MultiPar
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
-                wt = amrex::second() - wt;
-                amrex::HostDevice::Atomic::Add(&(*cost)[pti.index()], wt);
+                wt = WarpXUtilLoadBalance::CostClock() - wt;
+                WarpXUtilLoadBalance::AddCost(lev, pti.index(), CostPhase::Collisions, wt);
             }
         }
 
@@ -0,0 +1,325 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "Particles/Gather/ExternalParticleFieldTable.H"
+
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace amrex::literals;
+
+namespace
+{
+    /** Position (x, y, z) of the node (i, j, k) of the grid (the tables are not used in RZ) */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void getNodePosition (int i, int j, int k,
+                          amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> const& plo,
+                          amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> const& dx,
+                          amrex::Real& x, amrex::Real& y, amrex::Real& z) noexcept
+    {
+#if defined(WARPX_DIM_3D)
+        x = plo[0] + i*dx[0];
+        y = plo[1] + j*dx[1];
+        z = plo[2] + k*dx[2];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        x = plo[0] + i*dx[0];
+        y = 0._rt;
+        z = plo[1] + j*dx[1];
+        amrex::ignore_unused(k);
+#else
+        x = 0._rt;
+        y = 0._rt;
+        z = plo[0] + i*dx[0];
+        amrex::ignore_unused(j, k);
+#endif
+    }
+
+    /** Multilinear interpolation of data given on a Cartesian mesh (first axis fastest)
+     *
+     * The field is zero outside of the mesh, and uniform along the axes with a single point.
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    amrex::Real interpolateMesh (const amrex::Real* data,
+                                 amrex::GpuArray<int, 3> const& n,
+                                 amrex::GpuArray<amrex::Real, 3> const& lo,
+                                 amrex::GpuArray<amrex::Real, 3> const& dx,
+                                 amrex::GpuArray<amrex::Real, 3> const& pos) noexcept
+    {
+        int i0[3] = {0, 0, 0};
+        amrex::Real w[3] = {0._rt, 0._rt, 0._rt};
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            if (n[d] == 1) continue;
+            const amrex::Real s = (pos[d] - lo[d])/dx[d];
+            if (s < 0._rt || s > n[d] - 1) return 0._rt;
+            i0[d] = std::min(static_cast<int>(std::floor(s)), n[d] - 2);
+            w[d] = s - i0[d];
+        }
+
+        amrex::Real value = 0._rt;
+        for (int corner = 0; corner < (1 << AMREX_SPACEDIM); ++corner) {
+            amrex::Real weight = 1._rt;
+            long index = 0;
+            long stride = 1;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                const int upper = (corner >> d) & 1;
+                weight *= upper ? w[d] : 1._rt - w[d];
+                index += (i0[d] + upper)*stride;
+                stride *= n[d];
+            }
+            if (weight != 0._rt) value += weight*data[index];
+        }
+        return value;
+    }
+}
+
+void
+ExternalParticleFieldTable::SetParsers (Field field, std::array<const amrex::Parser*, 3> parsers)
+{
+#if defined(WARPX_DIM_RZ)
+    // The tables hold the Cartesian components of the field in the (r,z) plane:
+    // this would only be correct for fields that do not depend on theta
+    amrex::ignore_unused(field, parsers);
+    amrex::Abort(Utils::TextMsg::Err(
+        "Tabulating the external particle fields (particles.E_ext_particle_tabulate,"
+        " particles.B_ext_particle_tabulate) is not supported in RZ geometry"));
+#else
+    m_source[field] = Source::Parser;
+    m_parsers[field] = parsers;
+#endif
+}
+
+void
+ExternalParticleFieldTable::ReadFromFile (Field field, const std::string& path)
+{
+#ifndef WARPX_USE_OPENPMD
+    amrex::ignore_unused(field, path);
+    amrex::Abort(Utils::TextMsg::Err(
+        "WarpX has to be compiled with USE_OPENPMD=TRUE to be able"
+        " to read the external particle fields from a file"));
+#elif defined(WARPX_DIM_RZ)
+    amrex::ignore_unused(field, path);
+    amrex::Abort(Utils::TextMsg::Err(
+        "Reading the external particle fields from a file is not supported in RZ geometry"));
+#else
+    const std::string name = (field == E) ? "E" : "B";
+    FileData& fd = m_file_data[field];
+    std::array<std::vector<amrex::Real>, 3> h_data;
+
+    // axes of the mesh, in the order of the WarpX axes
+#   if defined(WARPX_DIM_3D)
+    const std::vector<std::string> expected_labels = {"x", "y", "z"};
+#   elif defined(WARPX_DIM_XZ)
+    const std::vector<std::string> expected_labels = {"x", "z"};
+#   else
+    const std::vector<std::string> expected_labels = {"z"};
+#   endif
+
+    if (amrex::ParallelDescriptor::IOProcessor()) {
+        openPMD::Series series(path, openPMD::Access::READ_ONLY);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(series.iterations.size() >= 1u,
+            "The external particle fields file " + path + " contains no iteration");
+        openPMD::Iteration it = series.iterations.begin()->second;
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(it.meshes.contains(name),
+            "The external particle fields file " + path + " contains no mesh " + name);
+        openPMD::Mesh mesh = it.meshes[name];
+
+        // The mesh attributes list the axes from the slowest to the fastest in C order,
+        // and from the fastest to the slowest in F order. The data is always stored with
+        // the last dimension of the extent fastest.
+        const bool is_c_order = mesh.dataOrder() == openPMD::Mesh::DataOrder::C;
+        auto labels = mesh.axisLabels();
+        auto spacing = mesh.gridSpacing<double>();
+        auto offset = mesh.gridGlobalOffset();
+        if (is_c_order) {
+            std::reverse(labels.begin(), labels.end());
+            std::reverse(spacing.begin(), spacing.end());
+            std::reverse(offset.begin(), offset.end());
+        }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(labels == expected_labels,
+            "The axes of the mesh " + name + " in " + path
+            + " do not match the dimensionality of the simulation");
+        const double grid_unit = mesh.gridUnitSI();
+
+        const std::vector<std::string> components = {"x", "y", "z"};
+        for (int icomp = 0; icomp < 3; ++icomp) {
+            openPMD::MeshRecordComponent rc = mesh[components[icomp]];
+            auto extent = rc.getExtent();
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(extent.size() == AMREX_SPACEDIM,
+                "The mesh " + name + " in " + path + " has the wrong number of dimensions");
+            auto position = rc.position<double>();
+            if (is_c_order) std::reverse(position.begin(), position.end());
+
+            std::size_t npoints = 1;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                const int n = static_cast<int>(extent[AMREX_SPACEDIM-1-d]);
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(icomp == 0 || n == fd.n[d],
+                    "The components of the mesh " + name + " in " + path + " have different extents");
+                fd.n[d] = n;
+                fd.dx[d] = static_cast<amrex::Real>(spacing[d]*grid_unit);
+                fd.lo[icomp][d] = static_cast<amrex::Real>((offset[d] + position[d]*spacing[d])*grid_unit);
+                npoints *= n;
+            }
+
+            const double unit = rc.unitSI();
+            h_data[icomp].resize(npoints);
+            const openPMD::Datatype dtype = rc.getDatatype();
+            if (dtype == openPMD::Datatype::FLOAT) {
+                std::shared_ptr<float> chunk = rc.loadChunk<float>();
+                series.flush();
+                for (std::size_t ip = 0; ip < npoints; ++ip) {
+                    h_data[icomp][ip] = static_cast<amrex::Real>(chunk.get()[ip]*unit);
+                }
+            } else if (dtype == openPMD::Datatype::DOUBLE) {
+                std::shared_ptr<double> chunk = rc.loadChunk<double>();
+                series.flush();
+                for (std::size_t ip = 0; ip < npoints; ++ip) {
+                    h_data[icomp][ip] = static_cast<amrex::Real>(chunk.get()[ip]*unit);
+                }
+            } else {
+                amrex::Abort(Utils::TextMsg::Err(
+                    "The mesh " + name + " in " + path + " must hold float or double data"));
+            }
+        }
+    }
+
+    // Share the mesh with all MPI ranks
+    const int root = amrex::ParallelDescriptor::IOProcessorNumber();
+    amrex::ParallelDescriptor::Bcast(fd.n.data(), 3, root);
+    amrex::ParallelDescriptor::Bcast(fd.dx.data(), 3, root);
+    for (int icomp = 0; icomp < 3; ++icomp) {
+        amrex::ParallelDescriptor::Bcast(fd.lo[icomp].data(), 3, root);
+        const std::size_t npoints = static_cast<std::size_t>(fd.n[0])*fd.n[1]*fd.n[2];
+        h_data[icomp].resize(npoints);
+        amrex::ParallelDescriptor::Bcast(h_data[icomp].data(), npoints, root);
+        fd.data[icomp].resize(npoints);
+        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+                              h_data[icomp].begin(), h_data[icomp].end(), fd.data[icomp].begin());
+    }
+    amrex::Gpu::synchronize();
+
+    m_source[field] = Source::File;
+#endif
+}
+
+void
+ExternalParticleFieldTable::Update ()
+{
+    if (!isDefined()) return;
+
+    const auto& warpx = WarpX::GetInstance();
+    const int nlevs = warpx.finestLevel() + 1;
+    m_table.resize(nlevs);
+    m_sampled_ba.resize(nlevs);
+    m_sampled_dm.resize(nlevs);
+    m_sampled_problo.resize(nlevs);
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+        const amrex::RealVect problo(warpx.Geom(lev).ProbLo());
+        if (m_table[lev] &&
+            m_sampled_ba[lev] == warpx.boxArray(lev) &&
+            m_sampled_dm[lev] == warpx.DistributionMap(lev) &&
+            m_sampled_problo[lev] == problo) continue;
+
+        Sample(lev);
+        m_sampled_ba[lev] = warpx.boxArray(lev);
+        m_sampled_dm[lev] = warpx.DistributionMap(lev);
+        m_sampled_problo[lev] = problo;
+    }
+}
+
+void
+ExternalParticleFieldTable::Sample (int lev)
+{
+    WARPX_PROFILE("ExternalParticleFieldTable::Sample()");
+
+    const auto& warpx = WarpX::GetInstance();
+    const amrex::Geometry& geom = warpx.Geom(lev);
+    const auto plo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+
+    m_table[lev] = std::make_unique<amrex::MultiFab>(
+        amrex::convert(warpx.boxArray(lev), amrex::IntVect::TheNodeVector()),
+        warpx.DistributionMap(lev), ncomps, warpx.get_ng_fieldgather());
+    amrex::MultiFab& table = *m_table[lev];
+    table.setVal(0._rt);
+
+    for (const Field field : {E, B}) {
+        const int dcomp = 3*field;
+
+        if (m_source[field] == Source::Parser) {
+            // the functions are sampled at t=0 (see <E,B>_ext_particle_time_function)
+            const auto fx = m_parsers[field][0]->compile<4>();
+            const auto fy = m_parsers[field][1]->compile<4>();
+            const auto fz = m_parsers[field][2]->compile<4>();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for (amrex::MFIter mfi(table, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const amrex::Box& bx = mfi.growntilebox();
+                const amrex::Array4<amrex::Real> arr = table.array(mfi);
+                amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    amrex::Real x, y, z;
+                    getNodePosition(i, j, k, plo, dx, x, y, z);
+                    arr(i, j, k, dcomp  ) = fx(x, y, z, 0._rt);
+                    arr(i, j, k, dcomp+1) = fy(x, y, z, 0._rt);
+                    arr(i, j, k, dcomp+2) = fz(x, y, z, 0._rt);
+                });
+            }
+        }
+        else if (m_source[field] == Source::File) {
+            const FileData& fd = m_file_data[field];
+            const auto n = fd.n;
+            const auto fdx = fd.dx;
+            for (int icomp = 0; icomp < 3; ++icomp) {
+                const auto flo = fd.lo[icomp];
+                const amrex::Real* data = fd.data[icomp].data();
+                const int comp = dcomp + icomp;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+                for (amrex::MFIter mfi(table, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                    const amrex::Box& bx = mfi.growntilebox();
+                    const amrex::Array4<amrex::Real> arr = table.array(mfi);
+                    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    {
+                        amrex::Real x, y, z;
+                        getNodePosition(i, j, k, plo, dx, x, y, z);
+                        // position along the axes of the mesh (the WarpX axes)
+#if defined(WARPX_DIM_3D)
+                        const amrex::GpuArray<amrex::Real, 3> pos = {x, y, z};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                        const amrex::GpuArray<amrex::Real, 3> pos = {x, z, 0._rt};
+#else
+                        const amrex::GpuArray<amrex::Real, 3> pos = {z, 0._rt, 0._rt};
+#endif
+                        arr(i, j, k, comp) = interpolateMesh(data, n, flo, fdx, pos);
+                    });
+                }
+            }
+        }
+    }
+}
@@ -1,10 +1,12 @@
 #include "Particles/Gather/GetExternalFields.H"
 
+#include "Particles/Gather/ExternalParticleFieldTable.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
 
+#include <AMReX_Geometry.H>
 #include <AMReX_Vector.H>
 
 #include <string>
@@ -41,8 +43,13 @@ GetExternalEBField::GetExternalEBField (const WarpXParIter& a_pti, int a_offset)
         m_Bfield_value[2] = mypc.m_B_external_particle[2];
     }
 
+    const ExternalParticleFieldTable& table = mypc.m_external_field_table;
+    const bool E_is_tabulated = table.isTabulated(ExternalParticleFieldTable::E);
+    const bool B_is_tabulated = table.isTabulated(ExternalParticleFieldTable::B);
+
     if (mypc.m_E_ext_particle_s == "parse_e_ext_particle_function" ||
         mypc.m_B_ext_particle_s == "parse_b_ext_particle_function" ||
+        E_is_tabulated || B_is_tabulated ||
         mypc.m_E_ext_particle_s == "repeated_plasma_lens" ||
         mypc.m_B_ext_particle_s == "repeated_plasma_lens")
     {
@@ -50,7 +57,7 @@ GetExternalEBField::GetExternalEBField (const WarpXParIter& a_pti, int a_offset)
         m_get_position = GetParticlePosition(a_pti, a_offset);
     }
 
-    if (mypc.m_E_ext_particle_s == "parse_e_ext_particle_function")
+    if (mypc.m_E_ext_particle_s == "parse_e_ext_particle_function" && !E_is_tabulated)
     {
         m_Etype = ExternalFieldInitType::Parser;
         m_Exfield_partparser = mypc.m_Ex_particle_parser->compile<4>();
@@ -58,7 +65,7 @@ GetExternalEBField::GetExternalEBField (const WarpXParIter& a_pti, int a_offset)
         m_Ezfield_partparser = mypc.m_Ez_particle_parser->compile<4>();
     }
 
-    if (mypc.m_B_ext_particle_s == "parse_b_ext_particle_function")
+    if (mypc.m_B_ext_particle_s == "parse_b_ext_particle_function" && !B_is_tabulated)
     {
         m_Btype = ExternalFieldInitType::Parser;
         m_Bxfield_partparser = mypc.m_Bx_particle_parser->compile<4>();
@@ -84,6 +91,47 @@ GetExternalEBField::GetExternalEBField (const WarpXParIter& a_pti, int a_offset)
         m_repeated_plasma_lens_strengths_B = mypc.d_repeated_plasma_lens_strengths_B.data();
     }
 
+    if (E_is_tabulated || B_is_tabulated)
+    {
+        const int lev = a_pti.GetLevel();
+        if (E_is_tabulated) {
+            m_Etype = Table;
+            if (mypc.m_E_ext_particle_time_parser) {
+                m_table_factor_E = mypc.m_E_ext_particle_time_parser->compileHost<1>()(m_time);
+            }
+        }
+        if (B_is_tabulated) {
+            m_Btype = Table;
+            if (mypc.m_B_ext_particle_time_parser) {
+                m_table_factor_B = mypc.m_B_ext_particle_time_parser->compileHost<1>()(m_time);
+            }
+        }
+
+        const amrex::FArrayBox& fab = table[lev][a_pti];
+        for (int icomp = 0; icomp < ExternalParticleFieldTable::ncomps; ++icomp) {
+            m_table_arr[icomp] = amrex::Array4<const amrex::Real>(fab.const_array(), icomp);
+        }
+
+        // Lower corner of the table box, in the 3D layout used by doGatherShapeN.
+        // The table is attached to the lab-frame grid: no Galilean shift.
+        const amrex::Box& box = fab.box();
+        const amrex::Geometry& geom = warpx.Geom(lev);
+        const std::array<amrex::Real,3>& dx = WarpX::CellSize(lev);
+        m_table_dx = {dx[0], dx[1], dx[2]};
+        m_table_lo = amrex::lbound(box);
+        m_table_xyzmin = {0._rt, 0._rt, 0._rt};
+#if defined(WARPX_DIM_3D)
+        for (int idim = 0; idim < 3; ++idim) {
+            m_table_xyzmin[idim] = geom.ProbLo(idim) + box.smallEnd(idim)*dx[idim];
+        }
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        m_table_xyzmin[0] = geom.ProbLo(0) + box.smallEnd(0)*dx[0];
+        m_table_xyzmin[2] = geom.ProbLo(1) + box.smallEnd(1)*dx[2];
+#else
+        m_table_xyzmin[2] = geom.ProbLo(0) + box.smallEnd(0)*dx[2];
+#endif
+    }
+
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_Etype != Unknown, "Unknown E_ext_particle_init_style");
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_Btype != Unknown, "Unknown B_ext_particle_init_style");
 
@@ -568,7 +568,7 @@ LaserParticleContainer::Evolve (int lev,
             {
                 amrex::Gpu::synchronize();
             }
-            Real wt = static_cast<Real>(amrex::second());
+            Real wt = WarpXUtilLoadBalance::CostClock();
 
             auto& attribs = pti.GetAttribs();
 
@@ -654,8 +654,8 @@ LaserParticleContainer::Evolve (int lev,
 
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
-                wt = static_cast<Real>(amrex::second()) - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+                wt = WarpXUtilLoadBalance::CostClock() - wt;
+                WarpXUtilLoadBalance::AddCost(lev, pti.index(), CostPhase::ParticlePush, wt);
             }
         }
     }
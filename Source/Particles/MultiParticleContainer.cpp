@@ -33,6 +33,7 @@
 #include "SpeciesPhysicalProperties.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXUtil.H"
 #ifdef AMREX_USE_EB
 #   include "EmbeddedBoundary/ParticleScraper.H"
 #   include "EmbeddedBoundary/ParticleBoundaryProcess.H"
@@ -67,10 +68,15 @@
 #include <AMReX_Utility.H>
 #include <AMReX_Vector.H>
 
+#ifdef AMREX_USE_OMP
+#   include <omp.h>
+#endif
+
 #include <algorithm>
 #include <cmath>
 #include <limits>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -226,6 +232,65 @@ MultiParticleContainer::ReadParameters ()
 
         }
 
+        // The external fields on the particles can be tabulated on the grid,
+        // either from the functions above or from an openPMD file. They are
+        // then gathered like the other fields, instead of evaluating the
+        // functions for every particle at every step.
+        bool E_ext_particle_tabulate = false;
+        bool B_ext_particle_tabulate = false;
+        pp_particles.query("E_ext_particle_tabulate", E_ext_particle_tabulate);
+        pp_particles.query("B_ext_particle_tabulate", B_ext_particle_tabulate);
+        // The functions are tabulated only once: they cannot depend on t
+        auto const assert_static = [] (amrex::Parser const* parser, std::string const& name) {
+            std::set<std::string> symbols = parser->symbols();
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(symbols.count("t") == 0,
+                "particles." + name + "_external_particle_function(x,y,z,t) depends on t,"
+                " so it cannot be tabulated. Use a function of (x,y,z) instead, multiplied by particles."
+                + name.substr(0, 1) + "_ext_particle_time_function(t)");
+        };
+        if (m_E_ext_particle_s == "parse_e_ext_particle_function" && E_ext_particle_tabulate) {
+            assert_static(m_Ex_particle_parser.get(), "Ex");
+            assert_static(m_Ey_particle_parser.get(), "Ey");
+            assert_static(m_Ez_particle_parser.get(), "Ez");
+            m_external_field_table.SetParsers(ExternalParticleFieldTable::E,
+                {m_Ex_particle_parser.get(), m_Ey_particle_parser.get(), m_Ez_particle_parser.get()});
+        }
+        if (m_B_ext_particle_s == "parse_b_ext_particle_function" && B_ext_particle_tabulate) {
+            assert_static(m_Bx_particle_parser.get(), "Bx");
+            assert_static(m_By_particle_parser.get(), "By");
+            assert_static(m_Bz_particle_parser.get(), "Bz");
+            m_external_field_table.SetParsers(ExternalParticleFieldTable::B,
+                {m_Bx_particle_parser.get(), m_By_particle_parser.get(), m_Bz_particle_parser.get()});
+        }
+        if (m_E_ext_particle_s == "read_from_file" || m_B_ext_particle_s == "read_from_file") {
+            std::string read_fields_from_path;
+            pp_particles.get("read_fields_from_path", read_fields_from_path);
+            if (m_E_ext_particle_s == "read_from_file") {
+                m_external_field_table.ReadFromFile(ExternalParticleFieldTable::E, read_fields_from_path);
+            }
+            if (m_B_ext_particle_s == "read_from_file") {
+                m_external_field_table.ReadFromFile(ExternalParticleFieldTable::B, read_fields_from_path);
+            }
+        }
+        if (m_external_field_table.isDefined()) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::gamma_boost <= 1._rt,
+                "The external fields on the particles cannot be tabulated in the boosted frame");
+        }
+        // The tabulated fields are static, unless they are multiplied by a function of time
+        std::string str_time_function;
+        if (m_external_field_table.isTabulated(ExternalParticleFieldTable::E) &&
+            pp_particles.query("E_ext_particle_time_function(t)", str_time_function)) {
+            Store_parserString(pp_particles, "E_ext_particle_time_function(t)", str_time_function);
+            m_E_ext_particle_time_parser = std::make_unique<amrex::Parser>(
+                makeParser(str_time_function, {"t"}));
+        }
+        if (m_external_field_table.isTabulated(ExternalParticleFieldTable::B) &&
+            pp_particles.query("B_ext_particle_time_function(t)", str_time_function)) {
+            Store_parserString(pp_particles, "B_ext_particle_time_function(t)", str_time_function);
+            m_B_ext_particle_time_parser = std::make_unique<amrex::Parser>(
+                makeParser(str_time_function, {"t"}));
+        }
+
         // if the input string for E_ext_particle_s or B_ext_particle_s is
         // "repeated_plasma_lens" then the plasma lens properties
         // must be provided in the input file.
@@ -407,6 +472,8 @@ MultiParticleContainer::InitData ()
 
     CheckIonizationProductSpecies();
 
+    m_external_field_table.Update();
+
 #ifdef WARPX_QED
     CheckQEDProductSpecies();
     InitQED();
@@ -425,6 +492,9 @@ MultiParticleContainer::Evolve (int lev,
                                 const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
                                 Real t, Real dt, DtType a_dt_type, bool skip_deposition)
 {
+    // sample the tabulated external fields again if the grids have changed
+    m_external_field_table.Update();
+
     if (! skip_deposition) {
         jx.setVal(0.0);
         jy.setVal(0.0);
@@ -435,12 +505,99 @@ MultiParticleContainer::Evolve (int lev,
         if (rho) rho->setVal(0.0);
         if (crho) crho->setVal(0.0);
     }
+
+#ifdef AMREX_USE_OMP
+    if (WarpX::do_species_tile_scheduling && amrex::Gpu::notInLaunchRegion()) {
+        EvolveScheduledTiles(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
+                             rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition);
+        return;
+    }
+#endif
+
     for (auto& pc : allcontainers) {
         pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
                    rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition);
     }
 }
 
+#ifdef AMREX_USE_OMP
+void
+MultiParticleContainer::EvolveScheduledTiles (int lev,
+                                              const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
+                                              const MultiFab& Bx, const MultiFab& By, const MultiFab& Bz,
+                                              MultiFab& jx, MultiFab& jy, MultiFab& jz,
+                                              MultiFab* cjx,  MultiFab* cjy, MultiFab* cjz,
+                                              MultiFab* rho, MultiFab* crho,
+                                              const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
+                                              const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
+                                              Real t, Real dt, DtType a_dt_type, bool skip_deposition)
+{
+    WARPX_PROFILE("MultiParticleContainer::EvolveScheduledTiles()");
+
+    // One work item per (species, tile) that contains particles
+    struct TileWork
+    {
+        PhysicalParticleContainer* pc;
+        std::pair<int,int> tile; // grid index and local tile index
+        amrex::Long np;
+    };
+    amrex::Vector<TileWork> work;
+
+    std::vector<PhysicalParticleContainer*> scheduled_species;
+    for (auto& pc : allcontainers) {
+        auto* ppc = dynamic_cast<PhysicalParticleContainer*>(pc.get());
+        if (ppc == nullptr) {
+            // e.g. the laser antennas, which do not have a tile-wise Evolve
+            pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
+                       rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition);
+            continue;
+        }
+        ppc->EvolveBegin(lev, dt);
+        scheduled_species.push_back(ppc);
+        for (auto const& kv : ppc->GetParticles(lev)) {
+            const amrex::Long np = kv.second.numParticles();
+            if (np > 0) work.push_back({ppc, kv.first, np});
+        }
+    }
+
+    // Largest tiles first, so that the threads that finish early pick up the small ones
+    std::stable_sort(work.begin(), work.end(),
+                     [] (TileWork const& a, TileWork const& b) { return a.np > b.np; });
+
+    const int nwork = static_cast<int>(work.size());
+#pragma omp parallel
+    {
+        const int thread_num = omp_get_thread_num();
+
+#pragma omp for schedule(dynamic,1)
+        for (int iw = 0; iw < nwork; ++iw)
+        {
+            TileWork const& w = work[iw];
+            // The particle iterator cannot be positioned on a given tile: walk the tiles
+            // of the species from a nested team of one thread (inside which the iterator
+            // is not split among threads), and advance the tile of this work item.
+            // The deposition uses the buffers of the outer thread (thread_num).
+#pragma omp parallel num_threads(1)
+            {
+                amrex::MFItInfo info;
+                for (WarpXParIter pti(*w.pc, lev, info, false); pti.isValid(); ++pti)
+                {
+                    if (pti.GetPairIndex() != w.tile) continue;
+                    w.pc->EvolveTile(pti, thread_num, lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz,
+                                     cjx, cjy, cjz, rho, crho, cEx, cEy, cEz, cBx, cBy, cBz,
+                                     dt, a_dt_type, skip_deposition);
+                    break;
+                }
+            }
+        }
+    }
+
+    for (auto* ppc : scheduled_species) {
+        ppc->EvolveEnd(lev, a_dt_type);
+    }
+}
+#endif
+
 void
 MultiParticleContainer::PushX (Real dt)
 {
@@ -454,6 +611,8 @@ MultiParticleContainer::PushP (int lev, Real dt,
                                const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
                                const MultiFab& Bx, const MultiFab& By, const MultiFab& Bz)
 {
+    m_external_field_table.Update();
+
     for (auto& pc : allcontainers) {
         pc->PushP(lev, dt, Ex, Ey, Ez, Bx, By, Bz);
     }
@@ -663,6 +822,8 @@ MultiParticleContainer::PostRestart ()
         pc->PostRestart();
     }
     pc_tmp->PostRestart();
+
+    m_external_field_table.Update();
 }
 
 void
@@ -919,7 +1080,7 @@ MultiParticleContainer::doFieldIonization (int lev,
             {
                 amrex::Gpu::synchronize();
             }
-            Real wt = amrex::second();
+            Real wt = WarpXUtilLoadBalance::CostClock();
 
             auto& src_tile = pc_source ->ParticlesAt(lev, pti);
             auto& dst_tile = pc_product->ParticlesAt(lev, pti);
@@ -937,8 +1098,8 @@ MultiParticleContainer::doFieldIonization (int lev,
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
-                wt = amrex::second() - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+                wt = WarpXUtilLoadBalance::CostClock() - wt;
+                WarpXUtilLoadBalance::AddCost(lev, pti.index(), CostPhase::Ionization, wt);
             }
         }
     }
@@ -1534,7 +1695,7 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
             {
                 amrex::Gpu::synchronize();
             }
-            Real wt = amrex::second();
+            Real wt = WarpXUtilLoadBalance::CostClock();
 
             auto Transform = PairGenerationTransformFunc(pair_gen_functor,
                                                          pti, lev, Ex.nGrowVect(),
@@ -1558,8 +1719,8 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
-                wt = amrex::second() - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+                wt = WarpXUtilLoadBalance::CostClock() - wt;
+                WarpXUtilLoadBalance::AddCost(lev, pti.index(), CostPhase::Ionization, wt);
             }
         }
     }
@@ -1609,7 +1770,7 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
             {
                 amrex::Gpu::synchronize();
             }
-            Real wt = amrex::second();
+            Real wt = WarpXUtilLoadBalance::CostClock();
 
             auto Transform = PhotonEmissionTransformFunc(
                   m_shr_p_qs_engine->build_optical_depth_functor(),
@@ -1637,8 +1798,8 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
-                wt = amrex::second() - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+                wt = WarpXUtilLoadBalance::CostClock() - wt;
+                WarpXUtilLoadBalance::AddCost(lev, pti.index(), CostPhase::Ionization, wt);
             }
         }
     }
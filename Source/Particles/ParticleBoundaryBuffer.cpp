@@ -19,6 +19,44 @@
 #include <AMReX_Tuple.H>
 #include <AMReX.H>
 
+#include <algorithm>
+#include <cstddef>
+
+namespace
+{
+    /** Factor by which the capacity of a buffer tile grows when it is full */
+    constexpr double buffer_growth_factor = 1.5;
+
+    /** Reserve memory in a buffer tile so that it can hold at least n particles.
+     *
+     * Scraped particles are appended to the buffers at every step, typically a few
+     * at a time: the capacity is thus grown geometrically, so that the number of
+     * reallocations (and copies of the whole buffer) is logarithmic in its size.
+     */
+    template <typename PTile>
+    void reserveGeometric (PTile& ptile, std::size_t n)
+    {
+        auto grow = [n] (auto& vec) {
+            if (n <= vec.capacity()) return;
+            vec.reserve(std::max(n, static_cast<std::size_t>(buffer_growth_factor*vec.capacity())));
+        };
+        grow(ptile.GetArrayOfStructs()());
+        auto& soa = ptile.GetStructOfArrays();
+        for (int j = 0; j < ptile.NumRealComps(); ++j) grow(soa.GetRealData(j));
+        for (int j = 0; j < ptile.NumIntComps(); ++j) grow(soa.GetIntData(j));
+    }
+
+    /** Remove all the particles of a buffer, but keep its tiles and their memory */
+    void resetBuffer (PinnedMemoryParticleContainer& pc)
+    {
+        for (int lev = 0; lev < pc.numLevels(); ++lev) {
+            for (auto& kv : pc.GetParticles(lev)) {
+                kv.second.resize(0);
+            }
+        }
+    }
+}
+
 struct IsOutsideDomainBoundary {
     amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> m_plo;
     amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> m_phi;
@@ -147,11 +185,18 @@ void ParticleBoundaryBuffer::clearParticles () {
         for (int ispecies = 0; ispecies < numSpecies(); ++ispecies)
         {
             auto& species_buffer = buffer[ispecies];
-            if (species_buffer.isDefined()) species_buffer.clearParticles();
+            if (species_buffer.isDefined()) resetBuffer(species_buffer);
         }
     }
 }
 
+void ParticleBoundaryBuffer::clearParticles (const std::string species_name, int boundary) {
+    auto& buffer = m_particle_containers[boundary];
+    auto index = WarpX::GetInstance().GetPartContainer().getSpeciesID(species_name);
+
+    if (buffer[index].isDefined()) resetBuffer(buffer[index]);
+}
+
 void ParticleBoundaryBuffer::gatherParticles (MultiParticleContainer& mypc,
                                               const amrex::Vector<const amrex::MultiFab*>& distance_to_eb)
 {
@@ -209,7 +254,9 @@ void ParticleBoundaryBuffer::gatherParticles (MultiParticleContainer& mypc,
                         auto dst_index = ptile_buffer.numParticles();
                         {
                           WARPX_PROFILE("ParticleBoundaryBuffer::gatherParticles::resize");
-                          ptile_buffer.resize(dst_index + amrex::get<0>(reduce_data.value()));
+                          auto const new_size = dst_index + amrex::get<0>(reduce_data.value());
+                          reserveGeometric(ptile_buffer, new_size);
+                          ptile_buffer.resize(new_size);
                         }
                         {
                           WARPX_PROFILE("ParticleBoundaryBuffer::gatherParticles::filterAndTransform");
@@ -283,7 +330,9 @@ void ParticleBoundaryBuffer::gatherParticles (MultiParticleContainer& mypc,
                 auto dst_index = ptile_buffer.numParticles();
                 {
                   WARPX_PROFILE("ParticleBoundaryBuffer::gatherParticles::resize_eb");
-                  ptile_buffer.resize(dst_index + amrex::get<0>(reduce_data.value()));
+                  auto const new_size = dst_index + amrex::get<0>(reduce_data.value());
+                  reserveGeometric(ptile_buffer, new_size);
+                  ptile_buffer.resize(new_size);
                 }
 
                 int timestamp_index = ptile_buffer.NumRuntimeIntComps()-1;
@@ -311,6 +360,27 @@ int ParticleBoundaryBuffer::getNumParticlesInContainer(
     else return 0;
 }
 
+amrex::Long ParticleBoundaryBuffer::getNumBytesInContainer(
+        const std::string species_name, int boundary) {
+
+    auto& buffer = m_particle_containers[boundary];
+    auto index = WarpX::GetInstance().GetPartContainer().getSpeciesID(species_name);
+
+    auto& pc = buffer[index];
+    if (!pc.isDefined()) return 0;
+
+    using ParticleType = PinnedMemoryParticleContainer::ParticleType;
+    amrex::Long const bytes_per_particle = sizeof(ParticleType)
+        + pc.NumRealComps()*sizeof(amrex::ParticleReal) + pc.NumIntComps()*sizeof(int);
+    amrex::Long bytes = 0;
+    for (int lev = 0; lev < pc.numLevels(); ++lev) {
+        for (auto const& kv : pc.GetParticles(lev)) {
+            bytes += kv.second.numParticles()*bytes_per_particle;
+        }
+    }
+    return bytes;
+}
+
 PinnedMemoryParticleContainer &
 ParticleBoundaryBuffer::getParticleBuffer(const std::string species_name, int boundary) {
 
@@ -10,7 +10,6 @@
  */
 #include "PhysicalParticleContainer.H"
 
-#include "Filter/NCIGodfreyFilter.H"
 #include "Initialization/InjectorDensity.H"
 #include "Initialization/InjectorMomentum.H"
 #include "Initialization/InjectorPosition.H"
@@ -58,7 +57,6 @@
 #include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_GpuDevice.H>
-#include <AMReX_GpuElixir.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_INT.H>
@@ -803,7 +801,7 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         const Box& tile_box = mfi.tilebox();
         const RealBox tile_realbox = WarpX::getRealBox(tile_box, lev);
@@ -1214,8 +1212,8 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
 
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(lev, mfi.index(), CostPhase::Other, wt);
         }
     }
 
@@ -1306,7 +1304,7 @@ PhysicalParticleContainer::AddPlasmaFlux (amrex::Real dt)
         {
             amrex::Gpu::synchronize();
         }
-        Real wt = amrex::second();
+        Real wt = WarpXUtilLoadBalance::CostClock();
 
         const Box& tile_box = mfi.tilebox();
         const RealBox tile_realbox = WarpX::getRealBox(tile_box, 0);
@@ -1657,8 +1655,8 @@ PhysicalParticleContainer::AddPlasmaFlux (amrex::Real dt)
 
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
-            wt = amrex::second() - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+            wt = WarpXUtilLoadBalance::CostClock() - wt;
+            WarpXUtilLoadBalance::AddCost(0, mfi.index(), CostPhase::Other, wt);
         }
     }
 
@@ -1702,17 +1700,35 @@ PhysicalParticleContainer::Evolve (int lev,
 {
 
     WARPX_PROFILE("PhysicalParticleContainer::Evolve()");
-    WARPX_PROFILE_VAR_NS("PhysicalParticleContainer::Evolve::GatherAndPush", blp_fg);
 
     BL_ASSERT(OnSameGrids(lev,jx));
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    EvolveBegin(lev, dt);
 
-    const iMultiFab* current_masks = WarpX::CurrentBufferMasks(lev);
-    const iMultiFab* gather_masks = WarpX::GatherBufferMasks(lev);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    {
+#ifdef AMREX_USE_OMP
+        int thread_num = omp_get_thread_num();
+#else
+        int thread_num = 0;
+#endif
 
-    bool has_buffer = cEx || cjx;
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            EvolveTile(pti, thread_num, lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz,
+                       cjx, cjy, cjz, rho, crho, cEx, cEy, cEz, cBx, cBy, cBz,
+                       dt, a_dt_type, skip_deposition);
+        }
+    }
+
+    EvolveEnd(lev, a_dt_type);
+}
 
+void
+PhysicalParticleContainer::EvolveBegin (int lev, Real /*dt*/)
+{
     if ( (WarpX::do_back_transformed_diagnostics && do_back_transformed_diagnostics) ||
          (m_do_back_transformed_particles) )
     {
@@ -1726,205 +1742,195 @@ PhysicalParticleContainer::Evolve (int lev,
                 tmp_particle_data[t_lev][index][i].resize(np);
         }
     }
+}
 
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-    {
-#ifdef AMREX_USE_OMP
-        int thread_num = omp_get_thread_num();
-#else
-        int thread_num = 0;
-#endif
-
-        FArrayBox filtered_Ex, filtered_Ey, filtered_Ez;
-        FArrayBox filtered_Bx, filtered_By, filtered_Bz;
-
-        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
-        {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-            }
-            Real wt = amrex::second();
-
-            const Box& box = pti.validbox();
-
-            // Extract particle data
-            auto& attribs = pti.GetAttribs();
-            auto&  wp = attribs[PIdx::w];
-            auto& uxp = attribs[PIdx::ux];
-            auto& uyp = attribs[PIdx::uy];
-            auto& uzp = attribs[PIdx::uz];
-
-            const long np = pti.numParticles();
-
-            // Data on the grid
-            FArrayBox const* exfab = &Ex[pti];
-            FArrayBox const* eyfab = &Ey[pti];
-            FArrayBox const* ezfab = &Ez[pti];
-            FArrayBox const* bxfab = &Bx[pti];
-            FArrayBox const* byfab = &By[pti];
-            FArrayBox const* bzfab = &Bz[pti];
+void
+PhysicalParticleContainer::EvolveTile (WarpXParIter& pti, int thread_num, int lev,
+                                       const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
+                                       const MultiFab& Bx, const MultiFab& By, const MultiFab& Bz,
+                                       MultiFab& jx, MultiFab& jy, MultiFab& jz,
+                                       MultiFab* cjx, MultiFab* cjy, MultiFab* cjz,
+                                       MultiFab* rho, MultiFab* crho,
+                                       const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
+                                       const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
+                                       Real dt, DtType a_dt_type, bool skip_deposition)
+{
+    WARPX_PROFILE_VAR_NS("PhysicalParticleContainer::Evolve::GatherAndPush", blp_fg);
 
-            Elixir exeli, eyeli, ezeli, bxeli, byeli, bzeli;
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
-            if (WarpX::use_fdtd_nci_corr)
-            {
-                // Filter arrays Ex[pti], store the result in
-                // filtered_Ex and update pointer exfab so that it
-                // points to filtered_Ex (and do the same for all
-                // components of E and B).
-                applyNCIFilter(lev, pti.tilebox(), exeli, eyeli, ezeli, bxeli, byeli, bzeli,
-                               filtered_Ex, filtered_Ey, filtered_Ez,
-                               filtered_Bx, filtered_By, filtered_Bz,
-                               Ex[pti], Ey[pti], Ez[pti], Bx[pti], By[pti], Bz[pti],
-                               exfab, eyfab, ezfab, bxfab, byfab, bzfab);
-            }
+    const iMultiFab* current_masks = WarpX::CurrentBufferMasks(lev);
+    const iMultiFab* gather_masks = WarpX::GatherBufferMasks(lev);
 
-            // Determine which particles deposit/gather in the buffer, and
-            // which particles deposit/gather in the fine patch
-            long nfine_current = np;
-            long nfine_gather = np;
-            if (has_buffer && !do_not_push) {
-                // - Modify `nfine_current` and `nfine_gather` (in place)
-                //    so that they correspond to the number of particles
-                //    that deposit/gather in the fine patch respectively.
-                // - Reorder the particle arrays,
-                //    so that the `nfine_current`/`nfine_gather` first particles
-                //    deposit/gather in the fine patch
-                //    and (thus) the `np-nfine_current`/`np-nfine_gather` last particles
-                //    deposit/gather in the buffer
-                PartitionParticlesInBuffers( nfine_current, nfine_gather, np,
-                    pti, lev, current_masks, gather_masks );
-            }
+    bool has_buffer = cEx || cjx;
 
-            const long np_current = (cjx) ? nfine_current : np;
+    if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+    {
+        amrex::Gpu::synchronize();
+    }
+    Real wt = WarpXUtilLoadBalance::CostClock();
+    // Part of wt spent in the field gather and push (the rest is deposition)
+    Real wt_push = 0._rt;
 
-            if (rho && ! skip_deposition) {
-                // Deposit charge before particle push, in component 0 of MultiFab rho.
-                int* AMREX_RESTRICT ion_lev;
-                if (do_field_ionization){
-                    ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
-                } else {
-                    ion_lev = nullptr;
-                }
-                DepositCharge(pti, wp, ion_lev, rho, 0, 0,
-                              np_current, thread_num, lev, lev);
-                if (has_buffer){
-                    DepositCharge(pti, wp, ion_lev, crho, 0, np_current,
-                                  np-np_current, thread_num, lev, lev-1);
-                }
-            }
+    // Extract particle data
+    auto& attribs = pti.GetAttribs();
+    auto&  wp = attribs[PIdx::w];
+    auto& uxp = attribs[PIdx::ux];
+    auto& uyp = attribs[PIdx::uy];
+    auto& uzp = attribs[PIdx::uz];
+
+    const long np = pti.numParticles();
+
+    // Data on the grid
+    // (when the NCI corrector is used, the fields were filtered in
+    // WarpX::PushParticlesandDepose, once for all species)
+    FArrayBox const* exfab = &Ex[pti];
+    FArrayBox const* eyfab = &Ey[pti];
+    FArrayBox const* ezfab = &Ez[pti];
+    FArrayBox const* bxfab = &Bx[pti];
+    FArrayBox const* byfab = &By[pti];
+    FArrayBox const* bzfab = &Bz[pti];
+
+    // Determine which particles deposit/gather in the buffer, and
+    // which particles deposit/gather in the fine patch
+    long nfine_current = np;
+    long nfine_gather = np;
+    if (has_buffer && !do_not_push) {
+        // - Modify `nfine_current` and `nfine_gather` (in place)
+        //    so that they correspond to the number of particles
+        //    that deposit/gather in the fine patch respectively.
+        // - Reorder the particle arrays,
+        //    so that the `nfine_current`/`nfine_gather` first particles
+        //    deposit/gather in the fine patch
+        //    and (thus) the `np-nfine_current`/`np-nfine_gather` last particles
+        //    deposit/gather in the buffer
+        PartitionParticlesInBuffers( nfine_current, nfine_gather, np,
+            pti, lev, current_masks, gather_masks );
+    }
 
-            if (! do_not_push)
-            {
-                const long np_gather = (cEx) ? nfine_gather : np;
+    const long np_current = (cjx) ? nfine_current : np;
 
-                int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
+    if (rho && ! skip_deposition) {
+        // Deposit charge before particle push, in component 0 of MultiFab rho.
+        int* AMREX_RESTRICT ion_lev;
+        if (do_field_ionization){
+            ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
+        } else {
+            ion_lev = nullptr;
+        }
+        DepositCharge(pti, wp, ion_lev, rho, 0, 0,
+                      np_current, thread_num, lev, lev);
+        if (has_buffer){
+            DepositCharge(pti, wp, ion_lev, crho, 0, np_current,
+                          np-np_current, thread_num, lev, lev-1);
+        }
+    }
 
-                //
-                // Gather and push for particles not in the buffer
-                //
-                WARPX_PROFILE_VAR_START(blp_fg);
-                PushPX(pti, exfab, eyfab, ezfab,
-                       bxfab, byfab, bzfab,
-                       Ex.nGrowVect(), e_is_nodal,
-                       0, np_gather, lev, lev, dt, ScaleFields(false), a_dt_type);
+    if (! do_not_push)
+    {
+        const long np_gather = (cEx) ? nfine_gather : np;
 
-                if (np_gather < np)
-                {
-                    const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
-                    const Box& cbox = amrex::coarsen(box,ref_ratio);
-
-                    // Data on the grid
-                    FArrayBox const* cexfab = &(*cEx)[pti];
-                    FArrayBox const* ceyfab = &(*cEy)[pti];
-                    FArrayBox const* cezfab = &(*cEz)[pti];
-                    FArrayBox const* cbxfab = &(*cBx)[pti];
-                    FArrayBox const* cbyfab = &(*cBy)[pti];
-                    FArrayBox const* cbzfab = &(*cBz)[pti];
-
-                    if (WarpX::use_fdtd_nci_corr)
-                    {
-                        // Filter arrays (*cEx)[pti], store the result in
-                        // filtered_Ex and update pointer cexfab so that it
-                        // points to filtered_Ex (and do the same for all
-                        // components of E and B)
-                        applyNCIFilter(lev-1, cbox, exeli, eyeli, ezeli, bxeli, byeli, bzeli,
-                                       filtered_Ex, filtered_Ey, filtered_Ez,
-                                       filtered_Bx, filtered_By, filtered_Bz,
-                                       (*cEx)[pti], (*cEy)[pti], (*cEz)[pti],
-                                       (*cBx)[pti], (*cBy)[pti], (*cBz)[pti],
-                                       cexfab, ceyfab, cezfab, cbxfab, cbyfab, cbzfab);
-                    }
+        int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
 
-                    // Field gather and push for particles in gather buffers
-                    e_is_nodal = cEx->is_nodal() and cEy->is_nodal() and cEz->is_nodal();
-                    PushPX(pti, cexfab, ceyfab, cezfab,
-                           cbxfab, cbyfab, cbzfab,
-                           cEx->nGrowVect(), e_is_nodal,
-                           nfine_gather, np-nfine_gather,
-                           lev, lev-1, dt, ScaleFields(false), a_dt_type);
-                }
+        //
+        // Gather and push for particles not in the buffer
+        //
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt_push = WarpXUtilLoadBalance::CostClock();
+        }
+        WARPX_PROFILE_VAR_START(blp_fg);
+        PushPX(pti, exfab, eyfab, ezfab,
+               bxfab, byfab, bzfab,
+               Ex.nGrowVect(), e_is_nodal,
+               0, np_gather, lev, lev, dt, ScaleFields(false), a_dt_type);
 
-                WARPX_PROFILE_VAR_STOP(blp_fg);
+        if (np_gather < np)
+        {
+            // Data on the grid
+            FArrayBox const* cexfab = &(*cEx)[pti];
+            FArrayBox const* ceyfab = &(*cEy)[pti];
+            FArrayBox const* cezfab = &(*cEz)[pti];
+            FArrayBox const* cbxfab = &(*cBx)[pti];
+            FArrayBox const* cbyfab = &(*cBy)[pti];
+            FArrayBox const* cbzfab = &(*cBz)[pti];
+
+            // Field gather and push for particles in gather buffers
+            e_is_nodal = cEx->is_nodal() and cEy->is_nodal() and cEz->is_nodal();
+            PushPX(pti, cexfab, ceyfab, cezfab,
+                   cbxfab, cbyfab, cbzfab,
+                   cEx->nGrowVect(), e_is_nodal,
+                   nfine_gather, np-nfine_gather,
+                   lev, lev-1, dt, ScaleFields(false), a_dt_type);
+        }
 
-                // Current Deposition
-                if (skip_deposition == false)
-                {
-                    // Deposit at t_{n+1/2}
-                    amrex::Real relative_time = -0.5_rt * dt;
+        WARPX_PROFILE_VAR_STOP(blp_fg);
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            amrex::Gpu::synchronize();
+            wt_push = WarpXUtilLoadBalance::CostClock() - wt_push;
+        }
 
-                    int* AMREX_RESTRICT ion_lev;
-                    if (do_field_ionization){
-                        ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
-                    } else {
-                        ion_lev = nullptr;
-                    }
-                    // Deposit inside domains
-                    DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, &jx, &jy, &jz,
-                                   0, np_current, thread_num,
-                                   lev, lev, dt, relative_time);
+        // Current Deposition
+        if (skip_deposition == false)
+        {
+            // Deposit at t_{n+1/2}
+            amrex::Real relative_time = -0.5_rt * dt;
 
-                    if (has_buffer)
-                    {
-                        // Deposit in buffers
-                        DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, cjx, cjy, cjz,
-                                       np_current, np-np_current, thread_num,
-                                       lev, lev-1, dt, relative_time);
-                    }
-                } // end of "if do_electrostatic == ElectrostaticSolverAlgo::None"
-            } // end of "if do_not_push"
-
-            if (rho && ! skip_deposition) {
-                // Deposit charge after particle push, in component 1 of MultiFab rho.
-                // (Skipped for electrostatic solver, as this may lead to out-of-bounds)
-                if (WarpX::do_electrostatic == ElectrostaticSolverAlgo::None) {
-                    int* AMREX_RESTRICT ion_lev;
-                    if (do_field_ionization){
-                        ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
-                    } else {
-                        ion_lev = nullptr;
-                    }
-                    DepositCharge(pti, wp, ion_lev, rho, 1, 0,
-                                  np_current, thread_num, lev, lev);
-                    if (has_buffer){
-                        DepositCharge(pti, wp, ion_lev, crho, 1, np_current,
-                                      np-np_current, thread_num, lev, lev-1);
-                    }
-                }
+            int* AMREX_RESTRICT ion_lev;
+            if (do_field_ionization){
+                ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
+            } else {
+                ion_lev = nullptr;
             }
+            // Deposit inside domains
+            DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, &jx, &jy, &jz,
+                           0, np_current, thread_num,
+                           lev, lev, dt, relative_time);
 
-            amrex::Gpu::synchronize();
-
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (has_buffer)
             {
-                wt = amrex::second() - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
+                // Deposit in buffers
+                DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, cjx, cjy, cjz,
+                               np_current, np-np_current, thread_num,
+                               lev, lev-1, dt, relative_time);
+            }
+        } // end of "if do_electrostatic == ElectrostaticSolverAlgo::None"
+    } // end of "if do_not_push"
+
+    if (rho && ! skip_deposition) {
+        // Deposit charge after particle push, in component 1 of MultiFab rho.
+        // (Skipped for electrostatic solver, as this may lead to out-of-bounds)
+        if (WarpX::do_electrostatic == ElectrostaticSolverAlgo::None) {
+            int* AMREX_RESTRICT ion_lev;
+            if (do_field_ionization){
+                ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr();
+            } else {
+                ion_lev = nullptr;
+            }
+            DepositCharge(pti, wp, ion_lev, rho, 1, 0,
+                          np_current, thread_num, lev, lev);
+            if (has_buffer){
+                DepositCharge(pti, wp, ion_lev, crho, 1, np_current,
+                              np-np_current, thread_num, lev, lev-1);
             }
         }
     }
+
+    amrex::Gpu::synchronize();
+
+    if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+    {
+        wt = WarpXUtilLoadBalance::CostClock() - wt;
+        WarpXUtilLoadBalance::AddCost(lev, pti.index(), CostPhase::ParticlePush, wt_push);
+        WarpXUtilLoadBalance::AddCost(lev, pti.index(), CostPhase::Deposition, wt - wt_push);
+    }
+}
+
+void
+PhysicalParticleContainer::EvolveEnd (int lev, DtType a_dt_type)
+{
     // Split particles at the end of the timestep.
     // When subcycling is ON, the splitting is done on the last call to
     // PhysicalParticleContainer::Evolve on the finest level, i.e., at the
@@ -1937,81 +1943,6 @@ PhysicalParticleContainer::Evolve (int lev,
     }
 }
 
-void
-PhysicalParticleContainer::applyNCIFilter (
-    int lev, const Box& box,
-    Elixir& exeli, Elixir& eyeli, Elixir& ezeli,
-    Elixir& bxeli, Elixir& byeli, Elixir& bzeli,
-    FArrayBox& filtered_Ex, FArrayBox& filtered_Ey, FArrayBox& filtered_Ez,
-    FArrayBox& filtered_Bx, FArrayBox& filtered_By, FArrayBox& filtered_Bz,
-    const FArrayBox& Ex, const FArrayBox& Ey, const FArrayBox& Ez,
-    const FArrayBox& Bx, const FArrayBox& By, const FArrayBox& Bz,
-    FArrayBox const * & ex_ptr, FArrayBox const * & ey_ptr,
-    FArrayBox const * & ez_ptr, FArrayBox const * & bx_ptr,
-    FArrayBox const * & by_ptr, FArrayBox const * & bz_ptr)
-{
-
-    // Get instances of NCI Godfrey filters
-    const auto& nci_godfrey_filter_exeybz = WarpX::GetInstance().nci_godfrey_filter_exeybz;
-    const auto& nci_godfrey_filter_bxbyez = WarpX::GetInstance().nci_godfrey_filter_bxbyez;
-
-#if defined(WARPX_DIM_1D_Z)
-    const Box& tbox = amrex::grow(box, static_cast<int>(WarpX::noz));
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    const Box& tbox = amrex::grow(box, {static_cast<int>(WarpX::nox),
-                static_cast<int>(WarpX::noz)});
-#else
-    const Box& tbox = amrex::grow(box, {static_cast<int>(WarpX::nox),
-                static_cast<int>(WarpX::noy),
-                static_cast<int>(WarpX::noz)});
-#endif
-
-    // Filter Ex (Both 2D and 3D)
-    filtered_Ex.resize(amrex::convert(tbox,Ex.box().ixType()));
-    // Safeguard for GPU
-    exeli = filtered_Ex.elixir();
-    // Apply filter on Ex, result stored in filtered_Ex
-
-    nci_godfrey_filter_exeybz[lev]->ApplyStencil(filtered_Ex, Ex, filtered_Ex.box());
-    // Update ex_ptr reference
-    ex_ptr = &filtered_Ex;
-
-    // Filter Ez
-    filtered_Ez.resize(amrex::convert(tbox,Ez.box().ixType()));
-    ezeli = filtered_Ez.elixir();
-    nci_godfrey_filter_bxbyez[lev]->ApplyStencil(filtered_Ez, Ez, filtered_Ez.box());
-    ez_ptr = &filtered_Ez;
-
-    // Filter By
-    filtered_By.resize(amrex::convert(tbox,By.box().ixType()));
-    byeli = filtered_By.elixir();
-    nci_godfrey_filter_bxbyez[lev]->ApplyStencil(filtered_By, By, filtered_By.box());
-    by_ptr = &filtered_By;
-#if defined(WARPX_DIM_3D)
-    // Filter Ey
-    filtered_Ey.resize(amrex::convert(tbox,Ey.box().ixType()));
-    eyeli = filtered_Ey.elixir();
-    nci_godfrey_filter_exeybz[lev]->ApplyStencil(filtered_Ey, Ey, filtered_Ey.box());
-    ey_ptr = &filtered_Ey;
-
-    // Filter Bx
-    filtered_Bx.resize(amrex::convert(tbox,Bx.box().ixType()));
-    bxeli = filtered_Bx.elixir();
-    nci_godfrey_filter_bxbyez[lev]->ApplyStencil(filtered_Bx, Bx, filtered_Bx.box());
-    bx_ptr = &filtered_Bx;
-
-    // Filter Bz
-    filtered_Bz.resize(amrex::convert(tbox,Bz.box().ixType()));
-    bzeli = filtered_Bz.elixir();
-    nci_godfrey_filter_exeybz[lev]->ApplyStencil(filtered_Bz, Bz, filtered_Bz.box());
-    bz_ptr = &filtered_Bz;
-#else
-    amrex::ignore_unused(eyeli, bxeli, bzeli,
-        filtered_Ey, filtered_Bx, filtered_Bz,
-        Ey, Bx, Bz, ey_ptr, bx_ptr, bz_ptr);
-#endif
-}
-
 // Loop over all particles in the particle container and
 // split particles tagged with p.id()=DoSplitParticleID
 void
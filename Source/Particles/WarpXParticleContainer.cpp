@@ -9,6 +9,7 @@
  */
 #include "WarpXParticleContainer.H"
 
+#include "ablastr/particles/AccumulateTile.H"
 #include "ablastr/particles/DepositCharge.H"
 #include "Deposition/ChargeDeposition.H"
 #include "Deposition/CurrentDeposition.H"
@@ -20,6 +21,7 @@
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
 #include <ablastr/utils/Communication.H>
@@ -81,6 +83,11 @@ WarpXParIter::WarpXParIter (ContainerType& pc, int level, MFItInfo& info)
 {
 }
 
+WarpXParIter::WarpXParIter (ContainerType& pc, int level, MFItInfo& info, bool dynamic)
+    : amrex::ParIter<0,0,PIdx::nattribs>(pc, level, info.SetDynamic(dynamic))
+{
+}
+
 WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     : NamedComponentParticleContainer<DefaultAllocator>(amr_core->GetParGDB())
     , species_id(ispecies)
@@ -171,90 +178,95 @@ WarpXParticleContainer::AddNParticles (int /*lev*/,
     PinnedTile pinned_tile;
     pinned_tile.define(NumRuntimeRealComps(), NumRuntimeIntComps());
 
-    std::size_t np = iend-ibegin;
-
-    // treat weight as a special attr since it will always be specified
-    Vector<ParticleReal> weight(np);
+    const std::size_t np = iend-ibegin;
 
+    if (np > 0)
+    {
+        // Size the staging tile once and write every component in place,
+        // rather than appending particle by particle and attribute by attribute.
+        pinned_tile.resize(np);
+
+        // Reserve a contiguous block of ids for the new particles
+        amrex::Long pid = id;
+        if (id == -1) {
+            pid = ParticleType::NextID();
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                pid + static_cast<amrex::Long>(np) <= LastParticleID,
+                "ERROR: overflow on particle id numbers");
+            ParticleType::NextID(pid + static_cast<amrex::Long>(np));
+        }
+        const int myproc = ParallelDescriptor::MyProc();
+
+        auto& soa = pinned_tile.GetStructOfArrays();
+        ParticleType* pstruct = pinned_tile.GetArrayOfStructs()().data();
+        ParticleReal* wp = soa.GetRealData(PIdx::w).data();
+        ParticleReal* uxp = soa.GetRealData(PIdx::ux).data();
+        ParticleReal* uyp = soa.GetRealData(PIdx::uy).data();
+        ParticleReal* uzp = soa.GetRealData(PIdx::uz).data();
 #ifdef WARPX_DIM_RZ
-    Vector<ParticleReal> theta(np);
+        ParticleReal* thetap = soa.GetRealData(PIdx::theta).data();
 #endif
 
-    for (int i = ibegin; i < iend; ++i)
-    {
-        ParticleType p;
-        if (id==-1)
+        for (std::size_t ip = 0; ip < np; ++ip)
         {
-            p.id() = ParticleType::NextID();
-        } else {
-            p.id() = id;
-        }
-        p.cpu() = ParallelDescriptor::MyProc();
+            const std::size_t i = ibegin + ip;
+            ParticleType& p = pstruct[ip];
+            p.id() = (id == -1) ? pid + static_cast<amrex::Long>(ip) : id;
+            p.cpu() = myproc;
 #if defined(WARPX_DIM_3D)
-        p.pos(0) = x[i];
-        p.pos(1) = y[i];
-        p.pos(2) = z[i];
+            p.pos(0) = x[i];
+            p.pos(1) = y[i];
+            p.pos(2) = z[i];
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        amrex::ignore_unused(y);
+            amrex::ignore_unused(y);
 #ifdef WARPX_DIM_RZ
-        theta[i-ibegin] = std::atan2(y[i], x[i]);
-        p.pos(0) = std::sqrt(x[i]*x[i] + y[i]*y[i]);
+            thetap[ip] = std::atan2(y[i], x[i]);
+            p.pos(0) = std::sqrt(x[i]*x[i] + y[i]*y[i]);
 #else
-        p.pos(0) = x[i];
+            p.pos(0) = x[i];
 #endif
-        p.pos(1) = z[i];
+            p.pos(1) = z[i];
 #else //AMREX_SPACEDIM == 1
-        amrex::ignore_unused(x,y);
-        p.pos(0) = z[i];
+            amrex::ignore_unused(x,y);
+            p.pos(0) = z[i];
 #endif
-
-        pinned_tile.push_back(p);
-
-        // grab weight from the attr array
-        weight[i-ibegin] = attr[i*nattr];
-    }
-
-    if (np > 0)
-    {
-        pinned_tile.push_back_real(PIdx::w , weight.data(), weight.data() + np);
-        pinned_tile.push_back_real(PIdx::ux,     vx + ibegin,     vx + iend);
-        pinned_tile.push_back_real(PIdx::uy,     vy + ibegin,     vy + iend);
-        pinned_tile.push_back_real(PIdx::uz,     vz + ibegin,     vz + iend);
-
-        if ( (NumRuntimeRealComps()>0) || (NumRuntimeIntComps()>0) ){
-            DefineAndReturnParticleTile(0, 0, 0);
+            // weight is a special attr since it will always be specified
+            wp[ip] = attr[i*nattr];
+            uxp[ip] = vx[i];
+            uyp[ip] = vy[i];
+            uzp[ip] = vz[i];
         }
 
         for (int comp = PIdx::uz+1; comp < PIdx::nattribs; ++comp)
         {
 #ifdef WARPX_DIM_RZ
-            if (comp == PIdx::theta) {
-                pinned_tile.push_back_real(comp, theta.data(), theta.data() + np);
-            }
-            else {
-                pinned_tile.push_back_real(comp, np, 0.0);
-            }
-#else
-            pinned_tile.push_back_real(comp, np, 0.0);
+            if (comp == PIdx::theta) continue;
 #endif
+            ParticleReal* arr = soa.GetRealData(comp).data();
+            std::fill(arr, arr + np, ParticleReal(0.0));
         }
 
         for (int j = PIdx::nattribs; j < NumRealComps(); ++j)
         {
-            if (j - PIdx::nattribs < nattr - 1) {
+            ParticleReal* arr = soa.GetRealData(j).data();
+            const int iattr = j - PIdx::nattribs + 1;
+            if (iattr < nattr) {
                 // get the next attribute from attr array
-                Vector<ParticleReal> attr_vals(np);
-                for (int i = ibegin; i < iend; ++i)
-                {
-                    attr_vals[i-ibegin] = attr[j - PIdx::nattribs + 1 + i*nattr];
+                for (std::size_t ip = 0; ip < np; ++ip) {
+                    arr[ip] = attr[iattr + (ibegin + ip)*nattr];
                 }
-                pinned_tile.push_back_real(j, attr_vals.data(), attr_vals.data() + np);
             }
             else {
-                pinned_tile.push_back_real(j, np, 0.0);
+                std::fill(arr, arr + np, ParticleReal(0.0));
             }
         }
 
+        for (int j = 0; j < NumIntComps(); ++j)
+        {
+            int* arr = soa.GetIntData(j).data();
+            std::fill(arr, arr + np, 0);
+        }
+
         auto old_np = particle_tile.numParticles();
         auto new_np = old_np + pinned_tile.numParticles();
         particle_tile.resize(new_np);
@@ -464,6 +476,29 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                 WarpX::n_rz_azimuthal_modes, cost,
                 WarpX::load_balance_costs_update_algo);
         }
+    } else if (WarpX::sorted_current_deposition) {
+        if        (WarpX::nox == 1){
+            doSortedDepositionShapeN<1>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, relative_time, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes, cost,
+                WarpX::load_balance_costs_update_algo);
+        } else if (WarpX::nox == 2){
+            doSortedDepositionShapeN<2>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, relative_time, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes, cost,
+                WarpX::load_balance_costs_update_algo);
+        } else if (WarpX::nox == 3){
+            doSortedDepositionShapeN<3>(
+                GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_fab, jy_fab, jz_fab, np_to_depose, relative_time, dx,
+                xyzmin, lo, q, WarpX::n_rz_azimuthal_modes, cost,
+                WarpX::load_balance_costs_update_algo);
+        }
     } else {
         if        (WarpX::nox == 1){
             doDepositionShapeN<1>(
@@ -491,11 +526,19 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
     WARPX_PROFILE_VAR_STOP(blp_deposit);
 
 #ifndef AMREX_USE_GPU
-    // CPU, tiling: atomicAdd local_j<xyz> into j<xyz>
     WARPX_PROFILE_VAR_START(blp_accumulate);
-    (*jx)[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
-    (*jy)[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
-    (*jz)[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+    if (lev == depos_lev) {
+        // CPU, tiling: add local_j<xyz> into j<xyz>, with atomics only in the guard shell of the tile
+        ablastr::particles::accumulate_tile((*jx)[pti], local_jx[thread_num], pti.tilebox(), tbx, ng_J, 0, jx->nComp());
+        ablastr::particles::accumulate_tile((*jy)[pti], local_jy[thread_num], pti.tilebox(), tby, ng_J, 0, jy->nComp());
+        ablastr::particles::accumulate_tile((*jz)[pti], local_jz[thread_num], pti.tilebox(), tbz, ng_J, 0, jz->nComp());
+    } else {
+        // CPU, tiling: atomicAdd local_j<xyz> into j<xyz>
+        // (coarsened tiles of the buffers may overlap beyond their guard cells)
+        (*jx)[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
+        (*jy)[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
+        (*jz)[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+    }
     WARPX_PROFILE_VAR_STOP(blp_accumulate);
 #endif
 }
@@ -935,7 +978,7 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
             {
                 amrex::Gpu::synchronize();
             }
-            Real wt = amrex::second();
+            Real wt = WarpXUtilLoadBalance::CostClock();
 
             //
             // Particle Push
@@ -963,8 +1006,8 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
             if (costs && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
             {
                 amrex::Gpu::synchronize();
-                wt = amrex::second() - wt;
-                amrex::HostDevice::Atomic::Add( &(*costs)[pti.index()], wt);
+                wt = WarpXUtilLoadBalance::CostClock() - wt;
+                WarpXUtilLoadBalance::AddCost(lev, pti.index(), CostPhase::ParticlePush, wt);
             }
         }
     }
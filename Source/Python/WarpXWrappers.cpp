@@ -11,6 +11,7 @@
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
 #include "Utils/WarpXUtil.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
@@ -37,6 +38,8 @@
 
 #include <array>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -486,6 +489,43 @@ namespace
         return data;
     }
 
+    amrex::ParticleReal** warpx_getParticleArraysBatch (
+            const char* char_species_name, const char** char_comp_names, int ncomps,
+            int lev, int* num_tiles, int** particles_per_tile ) {
+
+        const auto & mypc = WarpX::GetInstance().GetPartContainer();
+        const std::string species_name(char_species_name);
+        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+
+        // Look up all component indices once, instead of once per component and per call
+        const auto particle_comps = myspc.getParticleComps();
+        std::vector<int> comps(ncomps);
+        for (int icomp = 0; icomp < ncomps; ++icomp) {
+            const std::string comp_name(char_comp_names[icomp]);
+            const auto it = particle_comps.find(comp_name);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(it != particle_comps.end(),
+                "get_particle_arrays_batch: species " + species_name
+                + " has no component " + comp_name);
+            comps[icomp] = it->second;
+        }
+
+        *num_tiles = myspc.numLocalTilesAtLevel(lev);
+        *particles_per_tile = static_cast<int*>(malloc(*num_tiles*sizeof(int)));
+        memset(*particles_per_tile, 0, *num_tiles*sizeof(int));
+
+        auto data = static_cast<amrex::ParticleReal**>(
+            malloc((*num_tiles)*ncomps*sizeof(amrex::ParticleReal*)));
+        int i = 0;
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti, ++i) {
+            auto& soa = pti.GetStructOfArrays();
+            for (int icomp = 0; icomp < ncomps; ++icomp) {
+                data[i*ncomps + icomp] = (amrex::ParticleReal*) soa.GetRealData(comps[icomp]).dataPtr();
+            }
+            (*particles_per_tile)[i] = pti.numParticles();
+        }
+        return data;
+    }
+
     int warpx_getParticleCompIndex (
          const char* char_species_name, const char* char_comp_name )
     {
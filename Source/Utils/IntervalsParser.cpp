@@ -52,9 +52,11 @@ int SliceParser::nextContains (const int n) const
 
 int SliceParser::previousContains (const int n) const
 {
-    if (m_period <= 0) {return false;}
-    int previous = ((std::min(n-1,m_stop)-m_start)/m_period)*m_period+m_start;
-    if ((n < m_start) || (previous < 0)) {previous = 0;}
+    if (m_period <= 0 || n <= m_start) {return 0;}
+    const int last = std::min(n-1, m_stop);
+    if (last < m_start) {return 0;}
+    const int previous = ((last-m_start)/m_period)*m_period+m_start;
+    if (previous < 0) {return 0;}
     return previous;
 }
 
@@ -74,34 +76,55 @@ IntervalsParser::IntervalsParser (const std::vector<std::string>& instr_vec)
     for(const auto& inslc : insplit)
     {
         SliceParser temp_slice(inslc);
-        m_slices.push_back(temp_slice);
-        if ((temp_slice.getPeriod() > 0) &&
-               (temp_slice.getStop() >= temp_slice.getStart())) m_activated = true;
+        // slices that contain no integer do not contribute to any query
+        if ((temp_slice.getPeriod() <= 0) ||
+               (temp_slice.getStop() < temp_slice.getStart())) continue;
+        m_activated = true;
+        const bool is_duplicate = std::any_of(m_slices.begin(), m_slices.end(),
+            [&](const auto& slice){
+                return slice.getStart() == temp_slice.getStart() &&
+                       slice.getStop() == temp_slice.getStop() &&
+                       slice.getPeriod() == temp_slice.getPeriod();});
+        if (!is_duplicate) m_slices.push_back(temp_slice);
     }
+    // slices that start earlier are more likely to contain the next queries
+    std::sort(m_slices.begin(), m_slices.end(),
+        [](const auto& a, const auto& b){return a.getStart() < b.getStart();});
 }
 
-bool IntervalsParser::contains (const int n) const
+void IntervalsParser::updateWindow (const int n) const
 {
-    return std::any_of(m_slices.begin(), m_slices.end(),
+    if (m_window_defined && n >= m_window_lo && n < m_window_hi) return;
+
+    m_window_lo = n;
+    m_window_lo_contained = std::any_of(m_slices.begin(), m_slices.end(),
         [&](const auto& slice){return slice.contains(n);});
+    m_window_hi = std::numeric_limits<int>::max();
+    m_window_previous = 0;
+    for(const auto& slice: m_slices){
+        m_window_hi = std::min(slice.nextContains(n), m_window_hi);
+        m_window_previous = std::max(slice.previousContains(n), m_window_previous);
+    }
+    m_window_defined = true;
+}
+
+bool IntervalsParser::contains (const int n) const
+{
+    updateWindow(n);
+    return n == m_window_lo && m_window_lo_contained;
 }
 
 int IntervalsParser::nextContains (const int n) const
 {
-    int next = std::numeric_limits<int>::max();
-    for(const auto& slice: m_slices){
-        next = std::min(slice.nextContains(n),next);
-    }
-    return next;
+    updateWindow(n);
+    return m_window_hi;
 }
 
 int IntervalsParser::previousContains (const int n) const
 {
-    int previous = 0;
-    for(const auto& slice: m_slices){
-        previous = std::max(slice.previousContains(n),previous);
-    }
-    return previous;
+    updateWindow(n);
+    if (n > m_window_lo && m_window_lo_contained) {return m_window_lo;}
+    return m_window_previous;
 }
 
 int IntervalsParser::previousContainsInclusive (const int n) const
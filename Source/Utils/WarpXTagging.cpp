@@ -8,13 +8,22 @@
 
 #include <WarpX.H>
 
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_AmrCore.H>
 #include <AMReX_BaseFab.H>
 #include <AMReX_Config.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Parser.H>
+#include <AMReX_Particle.H>
 #include <AMReX_REAL.H>
 #include <AMReX_RealVect.H>
 #include <AMReX_SPACE.H>
@@ -22,17 +31,97 @@
 
 #include <AMReX_BaseFwd.H>
 
+#include <memory>
+
 using namespace amrex;
 
+namespace
+{
+    /** Number of macroparticles (of all species) in each cell of level lev.
+     * The particles that are stored on the finer levels are counted in the cell
+     * of level lev that contains them, so that the count does not drop in the
+     * region that is already refined.
+     *
+     * \param[in] mypc     all the particle species
+     * \param[in] amr_core mesh hierarchy
+     * \param[in] lev      mesh refinement level
+     */
+    std::unique_ptr<MultiFab>
+    CountParticlesInCells (MultiParticleContainer& mypc, const AmrCore& amr_core, const int lev)
+    {
+        auto particle_count = std::make_unique<MultiFab>(amr_core.boxArray(lev),
+                                                         amr_core.DistributionMap(lev), 1, 0);
+        particle_count->setVal(0._rt);
+
+        const auto plo = amr_core.Geom(lev).ProbLoArray();
+        const auto dxi = amr_core.Geom(lev).InvCellSizeArray();
+        const Box domain = amr_core.Geom(lev).Domain();
+
+        IntVect ratio = IntVect::TheUnitVector();
+        for (int plev = lev; plev <= amr_core.finestLevel(); ++plev)
+        {
+            if (plev > lev) ratio *= amr_core.refRatio(plev-1);
+            MultiFab plev_count(amrex::coarsen(amr_core.boxArray(plev), ratio),
+                                amr_core.DistributionMap(plev), 1, 0);
+            plev_count.setVal(0._rt);
+
+            for (int isp = 0; isp < mypc.nSpecies(); ++isp)
+            {
+                auto& pc = mypc.GetParticleContainer(isp);
+                if (plev >= static_cast<int>(pc.GetParticles().size())) continue;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+                for (WarpXParIter pti(pc, plev); pti.isValid(); ++pti)
+                {
+                    const Box& bx = plev_count[pti].box();
+                    auto const& count = plev_count.array(pti);
+                    const auto* AMREX_RESTRICT particles = pti.GetArrayOfStructs()().dataPtr();
+                    const long np = pti.numParticles();
+                    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip)
+                    {
+                        const IntVect iv = amrex::getParticleCell(particles[ip], plo, dxi, domain);
+                        if (bx.contains(iv)) {
+                            amrex::Gpu::Atomic::AddNoRet(&count(iv), 1._rt);
+                        }
+                    });
+                }
+            }
+            particle_count->ParallelAdd(plev_count, 0, 0, 1);
+        }
+        return particle_count;
+    }
+}
+
 void
 WarpX::ErrorEst (int lev, TagBoxArray& tags, Real /*time*/, int /*ngrow*/)
 {
+    WARPX_PROFILE("WarpX::ErrorEst()");
+
     const auto problo = Geom(lev).ProbLoArray();
     const auto dx = Geom(lev).CellSizeArray();
 
     const auto ftlo = fine_tag_lo;
     const auto fthi = fine_tag_hi;
 
+    // Cells where the user-defined function is positive
+    const bool use_ref_patch_function = (ref_patch_parser != nullptr);
+    amrex::ParserExecutor<3> ref_patch_function;
+    if (use_ref_patch_function) ref_patch_function = ref_patch_parser->compile<3>();
+
+    // Cells where |E| is above the threshold
+    // (with RZ, only the azimuthal mode 0 is considered)
+    const bool use_E_threshold = (refine_E_threshold > 0._rt) && Efield_fp[lev][0];
+    const Real E2_threshold = refine_E_threshold*refine_E_threshold;
+
+    // Cells that contain enough macroparticles
+    std::unique_ptr<MultiFab> particle_count;
+    if (refine_particles_per_cell > 0._rt) {
+        particle_count = CountParticlesInCells(*mypc, *this, lev);
+    }
+    const Real ppc_threshold = refine_particles_per_cell;
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -48,6 +137,43 @@ WarpX::ErrorEst (int lev, TagBoxArray& tags, Real /*time*/, int /*ngrow*/)
             if (pos > ftlo && pos < fthi) {
                 fab(i,j,k) = TagBox::SET;
             }
+            if (use_ref_patch_function) {
+#if defined(WARPX_DIM_1D_Z)
+                const Real x = 0._rt, y = 0._rt, z = pos[0];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                const Real x = pos[0], y = 0._rt, z = pos[1];
+#else
+                const Real x = pos[0], y = pos[1], z = pos[2];
+#endif
+                if (ref_patch_function(x,y,z) > 0._rt) {
+                    fab(i,j,k) = TagBox::SET;
+                }
+            }
         });
+
+        // The field and particle criteria are only evaluated in the valid cells
+        const Box& vbx = mfi.validbox();
+        if (use_E_threshold) {
+            // Each component is taken at its staggered location in the cell
+            auto const& Ex = Efield_fp[lev][0]->const_array(mfi);
+            auto const& Ey = Efield_fp[lev][1]->const_array(mfi);
+            auto const& Ez = Efield_fp[lev][2]->const_array(mfi);
+            ParallelFor(vbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                const Real E2 = Ex(i,j,k)*Ex(i,j,k) + Ey(i,j,k)*Ey(i,j,k) + Ez(i,j,k)*Ez(i,j,k);
+                if (E2 > E2_threshold) {
+                    fab(i,j,k) = TagBox::SET;
+                }
+            });
+        }
+        if (particle_count) {
+            auto const& count = particle_count->const_array(mfi);
+            ParallelFor(vbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                if (count(i,j,k) >= ppc_threshold) {
+                    fab(i,j,k) = TagBox::SET;
+                }
+            });
+        }
     }
 }
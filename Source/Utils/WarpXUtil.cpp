@@ -21,6 +21,7 @@
 #include <AMReX_Config.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_MFIter.H>
@@ -32,11 +33,16 @@
 #include <array>
 #include <cmath>
 #include <cstring>
+#include <ctime>
 #include <fstream>
 #include <set>
 #include <string>
 #include <limits>
 
+#ifdef AMREX_USE_OMP
+#   include <omp.h>
+#endif
+
 using namespace amrex;
 
 void PreparseAMReXInputIntArray(amrex::ParmParse& a_pp, char const * const input_str, const bool replace)
@@ -165,7 +171,9 @@ void ConvertLabParamsToBoost()
 
 
     pp_amr.query("max_level", max_level);
-    if (max_level > 0){
+    // The refinement box is optional when other tagging criteria are used
+    const bool fine_tag_box = (max_level > 0) && pp_warpx.contains("fine_tag_lo");
+    if (fine_tag_box){
       getArrWithParser(pp_warpx, "fine_tag_lo", fine_tag_lo);
       getArrWithParser(pp_warpx, "fine_tag_hi", fine_tag_hi);
     }
@@ -187,7 +195,7 @@ void ConvertLabParamsToBoost()
             convert_factor = 1._rt/( gamma_boost * ( 1 - beta_boost ) );
             prob_lo[idim] *= convert_factor;
             prob_hi[idim] *= convert_factor;
-            if (max_level > 0){
+            if (fine_tag_box){
               fine_tag_lo[idim] *= convert_factor;
               fine_tag_hi[idim] *= convert_factor;
             }
@@ -199,7 +207,7 @@ void ConvertLabParamsToBoost()
 
     pp_geometry.addarr("prob_lo", prob_lo);
     pp_geometry.addarr("prob_hi", prob_hi);
-    if (max_level > 0){
+    if (fine_tag_box){
       pp_warpx.addarr("fine_tag_lo", fine_tag_lo);
       pp_warpx.addarr("fine_tag_hi", fine_tag_hi);
     }
@@ -645,4 +653,36 @@ namespace WarpXUtilLoadBalance
             (WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers);
         return consistent;
     }
+
+    amrex::Real CostClock ()
+    {
+#if !defined(AMREX_USE_GPU) && defined(CLOCK_THREAD_CPUTIME_ID)
+        // Outside of an OpenMP parallel region, the timed work may start its own
+        // thread team (e.g. multi-threaded FFTs), whose CPU time is not counted
+        // in the calling thread: the wall-clock time is used instead
+#   ifdef AMREX_USE_OMP
+        bool const use_thread_time = omp_in_parallel();
+#   else
+        bool const use_thread_time = true;
+#   endif
+        if (use_thread_time) {
+            timespec ts;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            return static_cast<amrex::Real>(static_cast<double>(ts.tv_sec) + 1.e-9*static_cast<double>(ts.tv_nsec));
+        }
+#endif
+        return static_cast<amrex::Real>(amrex::second());
+    }
+
+    void AddCost (const int lev, const int i_box, const int phase, const amrex::Real wt)
+    {
+        amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+        if (cost) {
+            amrex::HostDevice::Atomic::Add( &(*cost)[i_box], wt);
+        }
+        WarpX::CostPhasesLayout* cost_phases = WarpX::getCostPhases(lev);
+        if (cost_phases) {
+            amrex::HostDevice::Atomic::Add( &(*cost_phases)[i_box][phase], wt);
+        }
+    }
 }
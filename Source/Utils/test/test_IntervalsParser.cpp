@@ -0,0 +1,44 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "Utils/IntervalsParser.H"
+
+#include <AMReX.H>
+#include <AMReX_BLassert.H>
+
+#include <string>
+#include <vector>
+
+/** Unit test of SliceParser and IntervalsParser, run with ctest */
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        const SliceParser slice("10:50:10");
+        // previousContains returns the greatest contained integer strictly smaller than n, or 0
+        AMREX_ALWAYS_ASSERT(slice.previousContains(5) == 0);
+        AMREX_ALWAYS_ASSERT(slice.previousContains(10) == 0);
+        AMREX_ALWAYS_ASSERT(slice.previousContains(11) == 10);
+        AMREX_ALWAYS_ASSERT(slice.previousContains(20) == 10);
+        AMREX_ALWAYS_ASSERT(slice.previousContains(21) == 20);
+        AMREX_ALWAYS_ASSERT(slice.previousContains(100) == 50);
+        AMREX_ALWAYS_ASSERT(slice.nextContains(10) == 20);
+
+        // The queries go through the cached window, in increasing and decreasing order
+        const IntervalsParser intervals(std::vector<std::string>{"10:50:10,35"});
+        AMREX_ALWAYS_ASSERT(intervals.contains(10));
+        AMREX_ALWAYS_ASSERT(intervals.previousContains(10) == 0);
+        AMREX_ALWAYS_ASSERT(intervals.previousContains(12) == 10);
+        AMREX_ALWAYS_ASSERT(intervals.nextContains(30) == 35);
+        AMREX_ALWAYS_ASSERT(intervals.previousContains(35) == 30);
+        AMREX_ALWAYS_ASSERT(intervals.previousContains(36) == 35);
+        AMREX_ALWAYS_ASSERT(intervals.localPeriod(36) == 5);
+        AMREX_ALWAYS_ASSERT(!intervals.contains(36));
+        AMREX_ALWAYS_ASSERT(intervals.previousContains(11) == 10);
+        AMREX_ALWAYS_ASSERT(intervals.previousContainsInclusive(70) == 70);
+    }
+    amrex::Finalize();
+}
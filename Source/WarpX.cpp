@@ -116,6 +116,8 @@ bool WarpX::do_compute_max_step_from_zmax = false;
 Real WarpX::zmax_plasma_to_compute_max_step = 0._rt;
 
 short WarpX::current_deposition_algo;
+bool WarpX::sorted_current_deposition = false;
+bool WarpX::fused_fdtd_update = false;
 short WarpX::charge_deposition_algo;
 short WarpX::field_gathering_algo;
 short WarpX::particle_pusher_algo;
@@ -178,6 +180,7 @@ Real WarpX::dt_slice_snapshots_lab;
 Real WarpX::particle_slice_width_lab = 0.0_rt;
 
 bool WarpX::do_dynamic_scheduling = true;
+bool WarpX::do_species_tile_scheduling = false;
 
 int WarpX::do_electrostatic;
 Real WarpX::self_fields_required_precision = 1.e-11_rt;
@@ -339,6 +342,7 @@ WarpX::WarpX ()
     do_pml_Hi.resize(nlevs_max);
 
     costs.resize(nlevs_max);
+    cost_phases.resize(nlevs_max);
     load_balance_efficiency.resize(nlevs_max);
 
     m_field_factory.resize(nlevs_max);
@@ -884,14 +888,52 @@ WarpX::ReadParameters ()
         }
 
         if (maxLevel() > 0) {
+            // The cells tagged for refinement (see WarpX::ErrorEst) are those inside
+            // the box [fine_tag_lo, fine_tag_hi], where ref_patch_function(x,y,z) > 0,
+            // or where the field or the number of macroparticles is above a threshold
             Vector<Real> lo, hi;
-            getArrWithParser(pp_warpx, "fine_tag_lo", lo);
-            getArrWithParser(pp_warpx, "fine_tag_hi", hi);
-            fine_tag_lo = RealVect{lo};
-            fine_tag_hi = RealVect{hi};
+            if (pp_warpx.contains("fine_tag_lo") || pp_warpx.contains("fine_tag_hi")) {
+                getArrWithParser(pp_warpx, "fine_tag_lo", lo);
+                getArrWithParser(pp_warpx, "fine_tag_hi", hi);
+                fine_tag_lo = RealVect{lo};
+                fine_tag_hi = RealVect{hi};
+            } else {
+                // Empty box: no cell is tagged from its position only
+                fine_tag_lo = RealVect(AMREX_D_DECL(std::numeric_limits<Real>::max(),
+                                                    std::numeric_limits<Real>::max(),
+                                                    std::numeric_limits<Real>::max()));
+                fine_tag_hi = RealVect(AMREX_D_DECL(std::numeric_limits<Real>::lowest(),
+                                                    std::numeric_limits<Real>::lowest(),
+                                                    std::numeric_limits<Real>::lowest()));
+            }
+
+            std::string str_ref_patch_function;
+            if (pp_warpx.contains("ref_patch_function(x,y,z)")) {
+                Store_parserString(pp_warpx, "ref_patch_function(x,y,z)", str_ref_patch_function);
+                ref_patch_parser = std::make_unique<amrex::Parser>(
+                    makeParser(str_ref_patch_function, {"x","y","z"}));
+            }
+            queryWithParser(pp_warpx, "refine_E_threshold", refine_E_threshold);
+            queryWithParser(pp_warpx, "refine_particles_per_cell", refine_particles_per_cell);
+
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !lo.empty() || ref_patch_parser || refine_E_threshold > 0._rt
+                || refine_particles_per_cell > 0._rt,
+                "With amr.max_level > 0, the cells to refine must be given by warpx.fine_tag_lo/hi,"
+                " warpx.ref_patch_function(x,y,z), warpx.refine_E_threshold"
+                " or warpx.refine_particles_per_cell");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                refine_particles_per_cell <= 0._rt || regrid_int > 0,
+                "warpx.refine_particles_per_cell requires warpx.regrid_int > 0,"
+                " since the particles are not injected yet when the initial grids are made");
         }
 
         pp_warpx.query("do_dynamic_scheduling", do_dynamic_scheduling);
+        pp_warpx.query("do_species_tile_scheduling", do_species_tile_scheduling);
+#ifdef AMREX_USE_GPU
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_species_tile_scheduling,
+            "warpx.do_species_tile_scheduling is only available on CPU");
+#endif
 
         pp_warpx.query("do_nodal", do_nodal);
         // Use same shape factors in all directions, for gathering
@@ -971,6 +1013,16 @@ WarpX::ReadParameters ()
             maxLevel() <= 0,
             "Vay deposition not implemented with mesh refinement");
 
+        pp_algo.query("sorted_current_deposition", sorted_current_deposition);
+#if defined(AMREX_USE_GPU) || defined(WARPX_DIM_RZ)
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!sorted_current_deposition,
+            "algo.sorted_current_deposition is only available on CPU and in Cartesian geometry");
+#endif
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !sorted_current_deposition ||
+            current_deposition_algo == CurrentDepositionAlgo::Direct,
+            "algo.sorted_current_deposition can only be used with algo.current_deposition = direct");
+
         field_gathering_algo = GetAlgorithmInteger(pp_algo, "field_gathering");
         if (field_gathering_algo == GatheringAlgo::MomentumConserving) {
             // Use same shape factors in all directions, for gathering
@@ -982,15 +1034,51 @@ WarpX::ReadParameters ()
             macroscopic_solver_algo = GetAlgorithmInteger(pp_algo,"macroscopic_sigma_method");
         }
 
+        pp_algo.query("fused_fdtd_update", fused_fdtd_update);
+        if (fused_fdtd_update) {
+#if defined(WARPX_DIM_RZ) || defined(AMREX_USE_EB)
+            amrex::Abort(Utils::TextMsg::Err(
+                "algo.fused_fdtd_update is only available in Cartesian geometry, without embedded boundaries"));
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxwell_solver_id == MaxwellSolverAlgo::Yee || maxwell_solver_id == MaxwellSolverAlgo::CKC,
+                "algo.fused_fdtd_update requires algo.maxwell_solver = yee or ckc");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                em_solver_medium == MediumForEM::Vacuum && !do_dive_cleaning && !do_divb_cleaning,
+                "algo.fused_fdtd_update is not implemented with a macroscopic medium or divergence cleaning");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(maxLevel() == 0,
+                "algo.fused_fdtd_update is not implemented with mesh refinement");
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                // The guard cells outside of the domain are only valid with periodic boundaries
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    WarpX::field_boundary_lo[idim] == FieldBoundaryType::Periodic &&
+                    WarpX::field_boundary_hi[idim] == FieldBoundaryType::Periodic,
+                    "algo.fused_fdtd_update requires periodic field boundaries");
+            }
+        }
+
         // Load balancing parameters
         std::vector<std::string> load_balance_intervals_string_vec = {"0"};
         pp_algo.queryarr("load_balance_intervals", load_balance_intervals_string_vec);
         load_balance_intervals = IntervalsParser(load_balance_intervals_string_vec);
         pp_algo.query("load_balance_with_sfc", load_balance_with_sfc);
         pp_algo.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
+        pp_algo.query("load_balance_distributed", load_balance_distributed);
+        queryWithParser(pp_algo, "load_balance_max_migration", load_balance_max_migration);
+        pp_algo.query("load_balance_split_merge", load_balance_split_merge);
+        queryWithParser(pp_algo, "load_balance_split_ratio", load_balance_split_ratio);
+        queryWithParser(pp_algo, "load_balance_merge_ratio", load_balance_merge_ratio);
         queryWithParser(pp_algo, "load_balance_efficiency_ratio_threshold",
                         load_balance_efficiency_ratio_threshold);
         load_balance_costs_update_algo = GetAlgorithmInteger(pp_algo, "load_balance_costs_update");
+        pp_algo.query("load_balance_costs_fit", load_balance_costs_fit);
+        queryWithParser(pp_algo, "load_balance_costs_fit_memory", load_balance_costs_fit_memory);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !load_balance_costs_fit || load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers,
+            "algo.load_balance_costs_fit requires algo.load_balance_costs_update = timers");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            load_balance_costs_fit_memory >= 0. && load_balance_costs_fit_memory < 1.,
+            "algo.load_balance_costs_fit_memory must be in [0, 1)");
         queryWithParser(pp_algo, "costs_heuristic_cells_wt", costs_heuristic_cells_wt);
         queryWithParser(pp_algo, "costs_heuristic_particles_wt", costs_heuristic_particles_wt);
 
@@ -1114,6 +1202,19 @@ WarpX::ReadParameters ()
     {
         ParmParse pp_psatd("psatd");
         pp_psatd.query("periodic_single_box_fft", fft_periodic_single_box);
+        pp_psatd.query("distributed_fft", fft_distributed);
+        if (fft_distributed) {
+#if !defined(WarpX_FFTW_MPI)
+            amrex::Abort(Utils::TextMsg::Err(
+                "psatd.distributed_fft=1 requires WarpX to be compiled with FFTW-MPI"));
+#endif
+#if defined(WARPX_DIM_RZ) || defined(WARPX_DIM_1D_Z)
+            amrex::Abort(Utils::TextMsg::Err(
+                "psatd.distributed_fft=1 is only implemented in 2D and 3D Cartesian geometry"));
+#endif
+            // A distributed FFT is a global FFT over the periodic domain, as with a single box
+            fft_periodic_single_box = true;
+        }
 
         std::string nox_str;
         std::string noy_str;
@@ -1286,6 +1387,21 @@ WarpX::ReadParameters ()
             "psatd.update_with_rho must be equal to 1 for comoving PSATD"
         );
 
+        pp_psatd.query("on_the_fly_coefficients", psatd_on_the_fly_coefficients);
+
+#   ifdef WARPX_DIM_RZ
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !psatd_on_the_fly_coefficients,
+            "psatd.on_the_fly_coefficients = 1 is not implemented in RZ geometry"
+        );
+#   endif
+
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !psatd_on_the_fly_coefficients ||
+            (v_galilean_is_zero && v_comoving_is_zero && !fft_do_time_averaging && !do_multi_J),
+            "psatd.on_the_fly_coefficients = 1 is implemented only for the standard PSATD algorithm"
+        );
+
         if (do_multi_J)
         {
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
@@ -1528,17 +1644,11 @@ WarpX::MakeNewLevelFromScratch (int lev, Real time, const BoxArray& new_grids,
     InitLevelData(lev, time);
 }
 
-// This is a virtual function.
-void
-WarpX::MakeNewLevelFromCoarse (int /*lev*/, amrex::Real /*time*/, const amrex::BoxArray& /*ba*/,
-                                         const amrex::DistributionMapping& /*dm*/)
-{
-    amrex::Abort(Utils::TextMsg::Err("MakeNewLevelFromCoarse: To be implemented"));
-}
-
 void
 WarpX::ClearLevel (int lev)
 {
+    ClearFilterScratch();
+
     for (int i = 0; i < 3; ++i) {
         Efield_aux[lev][i].reset();
         Bfield_aux[lev][i].reset();
@@ -1588,10 +1698,25 @@ WarpX::ClearLevel (int lev)
     }
 #endif
 
+    if (lev > 0) pml[lev].reset();
+
     costs[lev].reset();
+    cost_phases[lev].reset();
     load_balance_efficiency[lev] = -1;
 }
 
+void
+WarpX::ClearFilterScratch ()
+{
+    bilinear_filter.ClearScratch();
+    // The NCI filters of a level may be applied to the fields of the next level
+    // (coarse patch, buffers): the scratch MultiFabs of all levels are released
+    for (int lev = 0; lev < static_cast<int>(nci_godfrey_filter_exeybz.size()); ++lev) {
+        if (nci_godfrey_filter_exeybz[lev]) nci_godfrey_filter_exeybz[lev]->ClearScratch();
+        if (nci_godfrey_filter_bxbyez[lev]) nci_godfrey_filter_bxbyez[lev]->ClearScratch();
+    }
+}
+
 void
 WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& dm)
 {
@@ -1621,6 +1746,7 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         WarpX::m_v_galilean,
         WarpX::m_v_comoving,
         safe_guard_cells,
+        WarpX::fused_fdtd_update,
         WarpX::do_electrostatic,
         WarpX::do_multi_J,
         WarpX::fft_do_time_averaging,
@@ -1907,8 +2033,10 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
 #   else
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 geom[0].isAllPeriodic()        // domain is periodic in all directions
-                && ba.size() == 1 && lev == 0, // domain is decomposed in a single box
-                "The option `psatd.periodic_single_box_fft` can only be used for a periodic domain, decomposed in a single box");
+                && (ba.size() == 1 || fft_distributed) // domain is decomposed in a single box
+                && lev == 0,
+                "The option `psatd.periodic_single_box_fft` can only be used for a periodic domain, decomposed in a single box"
+                " (or in several boxes, with psatd.distributed_fft = 1)");
 #   endif
         }
         // Get the cell-centered box
@@ -2143,6 +2271,11 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     if (load_balance_intervals.isActivated())
     {
         costs[lev] = std::make_unique<LayoutData<Real>>(ba, dm);
+        if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            cost_phases[lev] = std::make_unique<CostPhasesLayout>(ba, dm);
+            for (int i : cost_phases[lev]->IndexArray()) (*cost_phases[lev])[i].fill(0.0);
+        }
         load_balance_efficiency[lev] = -1;
     }
 }
@@ -2181,6 +2314,7 @@ void WarpX::AllocLevelSpectralSolverRZ (amrex::Vector<std::unique_ptr<SpectralSo
                                                   solver_dt,
                                                   isAnyBoundaryPML(),
                                                   update_with_rho,
+                                                  current_correction,
                                                   fft_do_time_averaging,
                                                   do_multi_J,
                                                   do_dive_cleaning,
@@ -2236,11 +2370,14 @@ void WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolv
                                                 solver_dt,
                                                 pml_flag,
                                                 fft_periodic_single_box,
+                                                fft_distributed,
                                                 update_with_rho,
+                                                current_correction,
                                                 fft_do_time_averaging,
                                                 do_multi_J,
                                                 do_dive_cleaning,
-                                                do_divb_cleaning);
+                                                do_divb_cleaning,
+                                                psatd_on_the_fly_coefficients);
     spectral_solver[lev] = std::move(pss);
 }
 #   endif
@@ -2469,6 +2606,18 @@ WarpX::getCosts (int lev)
     }
 }
 
+WarpX::CostPhasesLayout*
+WarpX::getCostPhases (int lev)
+{
+    if (m_instance)
+    {
+        return m_instance->cost_phases[lev].get();
+    } else
+    {
+        return nullptr;
+    }
+}
+
 void
 WarpX::BuildBufferMasks ()
 {
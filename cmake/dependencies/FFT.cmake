@@ -43,6 +43,33 @@ if(WarpX_PSATD)
         fftw_add_define("${HAS_FFTW_OMP_LIB}")
     endfunction()
 
+    # Check if the found FFTW install location has an _mpi library, e.g.,
+    # libfftw3(f)_mpi.(a|so) shipped and if yes, set the WarpX_FFTW_MPI=1 define
+    # (distributed FFTs over all MPI ranks).
+    #
+    function(fftw_check_mpi library_paths fftw_precision_suffix)
+        find_library(HAS_FFTW_MPI_LIB fftw3${fftw_precision_suffix}_mpi
+            PATHS ${library_paths}
+            # this is intentional, so we don't mix different FFTW installs
+            # and only check what is in the location hinted by the
+            # "library_paths" variable
+            NO_DEFAULT_PATH
+            NO_PACKAGE_ROOT_PATH
+            NO_CMAKE_PATH
+            NO_CMAKE_ENVIRONMENT_PATH
+            NO_SYSTEM_ENVIRONMENT_PATH
+            NO_CMAKE_SYSTEM_PATH
+            NO_CMAKE_FIND_ROOT_PATH
+        )
+        if(HAS_FFTW_MPI_LIB)
+            message(STATUS "FFTW: Found MPI support")
+            target_link_libraries(WarpX::thirdparty::FFT INTERFACE ${HAS_FFTW_MPI_LIB})
+            target_compile_definitions(WarpX::thirdparty::FFT INTERFACE WarpX_FFTW_MPI=1)
+        else()
+            message(STATUS "FFTW: Could NOT find MPI support")
+        endif()
+    endfunction()
+
 
     # Various FFT implementations that we want to use #############################
     #
@@ -121,5 +148,8 @@ if(WarpX_PSATD)
         else()
             message(STATUS "FFTW: Did NOT search for OpenMP support (WarpX_COMPUTE!=OMP)")
         endif()
+        if(WarpX_MPI)
+            fftw_check_mpi("${WarpX_FFTW_LIBRARY_DIRS}" "${HFFTWp}")
+        endif()
     endif()
 endif(WarpX_PSATD)